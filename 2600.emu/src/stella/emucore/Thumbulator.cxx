@@ -134,14 +134,10 @@ Thumbulator::Thumbulator(const uInt16* rom_ptr, uInt16* ram_ptr, uInt32 rom_size
     cBase{c_base},
     cStart{c_start},
     cStack{c_stack},
-    decodedRom{make_unique<Op[]>(romSize / 2)},  // NOLINT
     ram{ram_ptr},
     configuration{configurefor},
     myCartridge{cartridge}
 {
-  for(uInt32 i = 0; i < romSize / 2; ++i)
-    decodedRom[i] = decodeInstructionWord(CONV_RAMROM(rom[i]));
-
   setConsoleTiming(ConsoleTiming::ntsc);
 #ifndef UNSAFE_OPTIMIZATIONS
   trapFatalErrors(traponfatal);
@@ -1092,6 +1088,15 @@ Thumbulator::Op Thumbulator::decodeInstructionWord(uint16_t inst) {
   return Op::invalid;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const std::array<Thumbulator::Op, 0x10000> Thumbulator::decodedOps = []
+{
+  std::array<Op, 0x10000> ops{};
+  for(uInt32 i = 0; i < ops.size(); ++i)
+    ops[i] = decodeInstructionWord(static_cast<uInt16>(i));
+  return ops;
+}();
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 int Thumbulator::execute()
 {
@@ -1110,15 +1115,7 @@ int Thumbulator::execute()
   ++_stats.instructions;
 #endif
 
-  Op decodedOp;
-#ifndef UNSAFE_OPTIMIZATIONS
-  if ((instructionPtr & 0xF0000000) == 0 && instructionPtr < romSize)
-    decodedOp = decodedRom[instructionPtr >> 1];
-  else
-    decodedOp = decodeInstructionWord(inst);
-#else
-  decodedOp = decodedRom[(instructionPtr & ROMADDMASK) >> 1];
-#endif
+  const Op decodedOp = decodedOps[inst];
 
 #ifdef COUNT_OPS
   ++opCount[int(decodedOp)];
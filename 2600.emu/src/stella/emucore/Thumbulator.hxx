@@ -238,6 +238,11 @@ class Thumbulator
 
     static Op decodeInstructionWord(uint16_t inst);
 
+    // Maps every possible 16-bit instruction word to its decoded op, so
+    // code running from both ROM and RAM skips decoding entirely and no
+    // invalidation is needed when the cartridge or ARM code modifies RAM
+    static const std::array<Op, 0x10000> decodedOps;
+
     void do_zflag(uInt32 x);
     void do_nflag(uInt32 x);
     void do_cflag(uInt32 a, uInt32 b, uInt32 c);
@@ -273,7 +278,6 @@ class Thumbulator
     uInt32 cBase{0};
     uInt32 cStart{0};
     uInt32 cStack{0};
-    const unique_ptr<Op[]> decodedRom;  // NOLINT
     uInt16* ram{nullptr};
     std::array<uInt32, 16> reg_norm; // normal execution mode, do not have a thread mode
     uInt32 cpsr{0};
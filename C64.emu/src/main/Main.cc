@@ -17,6 +17,7 @@
 #include <emuframework/EmuAppInlines.hh>
 #include <emuframework/EmuSystemInlines.hh>
 #include <imagine/thread/Semaphore.hh>
+#include <imagine/thread/ThreadRegistry.hh>
 #include <imagine/gui/AlertView.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
@@ -88,6 +89,7 @@ C64System::C64System(ApplicationContext ctx):
 		[this]()
 		{
 			emuThreadId = thisThreadId();
+			auto registration = helperThreads().registerThisThread("VICE");
 			execSem.acquire();
 			log.info("starting maincpu_mainloop()");
 			plugin.maincpu_mainloop();
@@ -495,9 +497,24 @@ void C64System::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 {
 	audioPtr = audio;
 	setCanvasSkipFrame(!video);
+	EmuVideoImage img;
+	if(video && canRenderCanvasDirect(*video))
+	{
+		img = video->startFrameWithFormat(taskCtx, canvasSrcPix.desc());
+		directCanvasPix = img.pixmap();
+		directCanvasRendered = false;
+	}
 	signalViceThreadAndWait();
-	if(video)
+	if(img)
+	{
+		directCanvasPix = {};
+		if(!directCanvasRendered)
+			renderCanvasDirect(img.pixmap()); // VICE didn't refresh the canvas this frame
+		img.endFrame();
+	}
+	else if(video)
 	{
+		syncCanvasMem();
 		video->startFrameWithAltFormat(taskCtx, canvasSrcPix);
 	}
 	audioPtr = {};
@@ -505,6 +522,7 @@ void C64System::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAudio
 
 void C64System::renderFramebuffer(EmuVideo &video)
 {
+	syncCanvasMem();
 	video.startFrameWithAltFormat({}, canvasSrcPix);
 }
 
@@ -130,10 +130,14 @@ public:
 	std::string defaultPaletteName{};
 	std::string lastMissingSysFile;
 	IG::PixmapView canvasSrcPix{};
+	IG::MutablePixmapView directCanvasPix{}; // locked video image VICE renders into during runFrame()
+	IG::WPt canvasSrcOffset{};
 	PixelFormat pixFmt{PixelFmtRGBA8888};
 	ViceSystem currSystem{};
 	bool viceThreadSignaled{};
 	bool inCPUTrap{};
+	bool directCanvasRendered{};
+	bool canvasMemStale{};
 	Property<JoystickMode, CFGKEY_DEFAULT_JOYSTICK_MODE,
 		PropertyDesc<JoystickMode>{.defaultValue = JoystickMode::Port2}> defaultJoystickMode;
 	Property<JoystickMode, CFGKEY_JOYSTICK_MODE,
@@ -199,6 +203,9 @@ public:
 	bool currSystemIsC64Or128() const;
 	void setReuSize(int size);
 	void resetCanvasSourcePixmap(struct video_canvas_s *c);
+	bool canRenderCanvasDirect(const EmuVideo &) const;
+	void renderCanvasDirect(IG::MutablePixmapView);
+	void syncCanvasMem();
 	ArchiveIO &firmwareArchive(CStringView path) const;
 	void setSystemFilesPath(CStringView path, FS::file_type);
 	void enterCPUTrap();
@@ -252,7 +259,6 @@ public:
 	void renderFramebuffer(EmuVideo &);
 	bool shouldFastForward() const;
 	bool onVideoRenderFormatChange(EmuVideo &, PixelFormat);
-	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(emuThreadId); }
 
 protected:
 	void initC64(EmuApp &app);
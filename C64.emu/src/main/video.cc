@@ -80,6 +80,8 @@ static IG::PixelDesc pixelDesc(IG::PixelFormat fmt)
 	return fmt.desc().nativeOrder();
 }
 
+static void refreshFullCanvas(video_canvas_t *canvas);
+
 static void updateInternalPixelFormat(struct video_canvas_s *c, IG::PixelFormat fmt)
 {
 	assumeExpr(isValidPixelFormat(fmt));
@@ -120,10 +122,69 @@ int video_canvas_set_palette(video_canvas_t *c, struct palette_s *palette)
 	return 0;
 }
 
+// Renders the visible canvas area into pix, which covers the canvas region starting at pixOffset
+static void renderCanvasRegion(struct video_canvas_s *c, IG::MutablePixmapView pix, IG::WPt pixOffset)
+{
+	auto viewport = c->viewport;
+	auto geometry = c->geometry;
+	int xs = viewport->first_x + geometry->extra_offscreen_border_left;
+	int ys = viewport->first_line;
+	int xi = viewport->x_offset;
+	int yi = viewport->y_offset;
+	int w = std::min(c->draw_buffer->canvas_width, geometry->screen_size.width - viewport->first_x);
+	int h = std::min(c->draw_buffer->canvas_height, viewport->last_line - viewport->first_line + 1);
+	int x1 = std::max(xi, pixOffset.x);
+	int y1 = std::max(yi, pixOffset.y);
+	int x2 = std::min(xi + w, pixOffset.x + pix.w());
+	int y2 = std::min(yi + h, pixOffset.y + pix.h());
+	if(x2 <= x1 || y2 <= y1)
+		return;
+	c64Sys(c).plugin.video_canvas_render(c, (uint8_t*)pix.data(), x2 - x1, y2 - y1,
+		xs + (x1 - xi), ys + (y1 - yi), x1 - pixOffset.x, y1 - pixOffset.y, pix.pitchBytes());
+}
+
+bool C64System::canRenderCanvasDirect(const EmuVideo &video) const
+{
+	auto c = activeCanvas;
+	return c && c->created && c->pixmapData
+		&& c->videoconfig->scalex == 1 && c->videoconfig->scaley == 1
+		&& canvasSrcPix.format() == video.renderPixelFormat()
+		// the renderer may still be reading a single buffered image, so use the copy path
+		&& !video.isSingleBuffered();
+}
+
+void C64System::renderCanvasDirect(IG::MutablePixmapView pix)
+{
+	renderCanvasRegion(activeCanvas, pix, canvasSrcOffset);
+	canvasMemStale = true;
+}
+
+void C64System::syncCanvasMem()
+{
+	if(!canvasMemStale || !activeCanvas)
+		return;
+	// canvas memory missed updates while rendering directly to the video image
+	canvasMemStale = false;
+	refreshFullCanvas(activeCanvas);
+}
+
 void video_canvas_refresh(struct video_canvas_s *c, unsigned int xs, unsigned int ys, unsigned int xi, unsigned int yi, unsigned int w, unsigned int h)
 {
 	if(!c->created) [[unlikely]]
 		return;
+	auto &sys = c64Sys(c);
+	if(sys.directCanvasPix && c == sys.activeCanvas)
+	{
+		if(sys.directCanvasPix.size() == sys.canvasSrcPix.size())
+		{
+			// the video image may not contain the previous frame, so always render the full canvas
+			sys.renderCanvasDirect(sys.directCanvasPix);
+			sys.directCanvasRendered = true;
+			return;
+		}
+		// canvas was resized during the frame, update canvas memory for the next frame
+		sys.canvasMemStale = true;
+	}
 	xi *= c->videoconfig->scalex;
 	w *= c->videoconfig->scalex;
 	yi *= c->videoconfig->scaley;
@@ -159,10 +220,12 @@ void C64System::resetCanvasSourcePixmap(struct video_canvas_s *c)
 		int width = 320+(xBorderSize*2 - startX*2);
 		int widthPadding = startX*2;
 		canvasSrcPix = pixmapView(c).subView({startX, startY}, {width, height});
+		canvasSrcOffset = {startX, startY};
 	}
 	else
 	{
 		canvasSrcPix = pixmapView(c);
+		canvasSrcOffset = {};
 	}
 }
 
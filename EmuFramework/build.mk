@@ -1,8 +1,11 @@
 include $(IMAGINE_PATH)/make/imagineStaticLibBase.mk
 
 SRC += \
+AVRecorder.cc \
 AutosaveManager.cc \
 ConfigFile.cc \
+ContentArchiveCache.cc \
+ContentPrefetcher.cc \
 EmuApp.cc \
 EmuAudio.cc \
 EmuInput.cc \
@@ -12,13 +15,16 @@ EmuSystemTask.cc \
 EmuTiming.cc \
 EmuVideo.cc \
 EmuVideoLayer.cc \
+FrameHashRecorder.cc \
 InputDeviceConfig.cc \
 InputDeviceData.cc \
 KeyConfig.cc \
+MemorySearch.cc \
 OutputTimingManager.cc \
 pathUtils.cc \
 RecentContent.cc \
 RewindManager.cc \
+ScreenshotWriter.cc \
 ToggleInput.cc \
 TurboInput.cc \
 VideoImageEffect.cc \
@@ -43,6 +49,7 @@ gui/LoadProgressView.cc \
 gui/MainMenuView.cc \
 gui/PlaceVControlsView.cc \
 gui/PlaceVideoView.cc \
+gui/RAMSearchView.cc \
 gui/RecentContentView.cc \
 gui/StateSlotView.cc \
 gui/SystemActionsView.cc \
@@ -0,0 +1,112 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/Format.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/time/Time.hh>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Records emulated video and audio to an uncompressed AVI file. The emulation thread
+// copies each frame or sample batch into a pooled buffer and hands it to the writer
+// thread, when the pools run out data is dropped instead of waiting on the file
+class AVRecorder
+{
+public:
+	enum class StopReason : uint8_t { none, frameSizeChanged, fileFull, writeError };
+
+	AVRecorder() = default;
+	~AVRecorder() { stop(); }
+	bool start(FileIO, WSize frameSize, Nanoseconds frameTime, Audio::Format audioFormat);
+	void stop();
+	bool isRecording() const { return thread.joinable(); }
+	// returns false the first time the recording can't continue, either since a frame doesn't
+	// match the stream's size or the file can't take more data, the recording ignores further
+	// data from then on and the caller should stop it and report stopReason()
+	bool addVideo(PixmapView);
+	void addAudio(const void *samples, size_t bytes);
+	StopReason stopReason() const { return stopReason_.load(std::memory_order_relaxed); }
+
+private:
+	enum class ChunkType : uint8_t { video, audio };
+
+	struct Packet
+	{
+		std::vector<uint8_t> data;
+		ChunkType type{};
+	};
+
+	struct IndexEntry
+	{
+		uint32_t id;
+		uint32_t flags;
+		uint32_t offset;
+		uint32_t size;
+	};
+
+	struct HeaderOffsets
+	{
+		size_t totalFrames{};
+		size_t videoLength{};
+		size_t audioLength{};
+		size_t movi{};
+	};
+
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable queueCond;
+	std::deque<Packet> queue;
+	std::vector<std::vector<uint8_t>> videoPool;
+	std::vector<std::vector<uint8_t>> audioPool;
+	std::atomic_uint32_t pendingDroppedFrames{};
+	std::atomic<StopReason> stopReason_{};
+	bool stopPending{}; // accessed only by the emulation thread
+	uint32_t droppedFrames{};
+	uint32_t droppedAudioPackets{};
+	bool quitting{};
+	// accessed only by the writer thread while recording
+	FileIO file;
+	std::vector<IndexEntry> index;
+	HeaderOffsets headerOffsets;
+	uint64_t moviBytes{};
+	uint32_t videoFrames{};
+	uint32_t audioFrames{};
+	bool fileFull{};
+	WSize frameSize;
+	Audio::Format audioFormat;
+
+	bool writeHeader(Nanoseconds frameTime);
+	void run();
+	void writeChunk(ChunkType, std::span<const uint8_t> data);
+	void finishFile();
+	bool takeBuffer(std::vector<std::vector<uint8_t>> &pool, std::vector<uint8_t> &buff);
+	void submit(Packet);
+	void setStopReason(StopReason);
+};
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+// Active RAM codes resolved to host pointers when the cheat list changes,
+// so applying them each frame is a single pass of small stores
+class CheatPatchList
+{
+public:
+	void clear() { patches.clear(); }
+	bool empty() const { return patches.empty(); }
+	size_t size() const { return patches.size(); }
+
+	// value is in host byte order, bytes is 1, 2, or 4
+	bool add(std::span<uint8_t> mem, size_t offset, uint32_t value, uint8_t bytes)
+	{
+		if(offset + bytes > mem.size() || (bytes != 1 && bytes != 2 && bytes != 4))
+			return false;
+		patches.emplace_back(&mem[offset], value, bytes);
+		return true;
+	}
+
+	// address is in the system's memory map, resolved using the region containing it
+	bool add(std::span<const MemoryRegion> regions, uint32_t address, uint32_t value, uint8_t bytes)
+	{
+		for(auto &r : regions)
+		{
+			if(address >= r.address && address - r.address < r.data.size())
+				return add(r.data, address - r.address, value, bytes);
+		}
+		return false;
+	}
+
+	[[gnu::hot]] void apply() const
+	{
+		for(const auto &p : patches)
+		{
+			switch(p.bytes)
+			{
+				case 1: *p.dest = p.value; break;
+				case 2: { uint16_t v = p.value; std::memcpy(p.dest, &v, 2); break; }
+				default: std::memcpy(p.dest, &p.value, 4);
+			}
+		}
+	}
+
+private:
+	struct Patch
+	{
+		uint8_t *dest;
+		uint32_t value;
+		uint8_t bytes;
+	};
+
+	std::vector<Patch> patches;
+};
+
+}
@@ -34,7 +34,9 @@ public:
 
 protected:
 	TextMenuItem edit;
+	TextMenuItem ramSearch;
 	std::vector<BoolMenuItem> cheat;
+	bool hasRAMSearch{};
 
 	virtual void loadCheatItems() = 0;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace IG
+{
+class ArchiveIO;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+// Keeps extracted archive entries in the app's cache directory so reloading an archive
+// skips decompression and the entry scan, least recently used entries are removed
+// once the total size exceeds maxSize. Safe to use from the content prefetcher thread
+class ContentArchiveCache
+{
+public:
+	static constexpr size_t maxSize = 512 * 1024 * 1024;
+
+	ContentArchiveCache(ApplicationContext);
+	// key for the archive's path, size, and last write time
+	uint64_t archiveKey(CStringView path, size_t archiveSize) const;
+	// returns the cached entry for the key if present and sets the entry's name in the archive
+	FileIO open(uint64_t key, FS::FileString &nameOut);
+	bool canStore(size_t entrySize) const { return dir.size() && entrySize && entrySize <= maxSize; }
+	// extracts the entry into the cache and returns it, or an empty FileIO on error
+	FileIO add(uint64_t key, ArchiveIO &entry);
+	// removes every entry and returns the number of bytes freed
+	uint64_t clear();
+	uint64_t totalSize() const;
+
+private:
+	struct Entry
+	{
+		uint64_t key{};
+		int64_t lastUse{};
+		uint64_t size{};
+		uint32_t crc{};
+		FS::FileString name;
+	};
+
+	ApplicationContext ctx;
+	FS::PathString dir;
+	mutable std::mutex mutex;
+	std::vector<Entry> entries;
+
+	uint64_t entriesSize() const;
+	FS::PathString entryPath(const Entry &) const;
+	void removeEntry(std::vector<Entry>::iterator);
+	void evict(size_t neededSize);
+	void readIndex();
+	void writeIndex() const;
+};
+
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/IO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class ContentArchiveCache;
+
+// Reads content the user is likely to open next into memory on a background thread,
+// so loading it skips the file I/O. Archives are extracted into the ContentArchiveCache
+// instead when it's enabled, so loading them maps the cached file rather than keeping a
+// second copy in memory. Entries are checked against the file's last write time when
+// taken and the oldest are dropped once maxEntries or maxSize is exceeded
+class ContentPrefetcher
+{
+public:
+	static constexpr size_t maxSize = 64 * 1024 * 1024;
+	static constexpr size_t maxEntries = 4;
+
+	ContentPrefetcher(ApplicationContext ctx, ContentArchiveCache &archiveCache):
+		ctx{ctx}, archiveCache{archiveCache} {}
+	~ContentPrefetcher();
+	// queues the content to be read, replacing any request that hasn't started yet
+	void prefetch(CStringView path, std::string_view displayName);
+	// returns the content if present and sets its name in the archive, the rest of the cache
+	// is freed since it's only useful until something is loaded
+	IO take(CStringView path, FS::FileString &nameOut);
+	void clear();
+
+private:
+	struct Entry
+	{
+		FS::PathString path;
+		FS::FileString name;
+		WallClockTimePoint lastWriteTime;
+		IOBuffer data;
+	};
+
+	ApplicationContext ctx;
+	ContentArchiveCache &archiveCache;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable requestCond;
+	FS::PathString requestPath;
+	FS::FileString requestName;
+	bool requestUsesArchiveCache{};
+	FS::PathString lastRequestPath; // avoids queuing the same content again on repeated calls
+	std::vector<Entry> entries; // oldest first
+	uint32_t generation{}; // incremented when the cache is cleared to drop reads in progress
+	bool quitting{};
+
+	void run();
+	Entry read(CStringView path, std::string_view displayName, WallClockTimePoint lastWriteTime, bool usesArchiveCache) const;
+	void addToArchiveCache(CStringView path, IO) const;
+	size_t totalSize() const;
+};
+
+}
@@ -27,6 +27,12 @@
 #include <emuframework/OutputTimingManager.hh>
 #include <emuframework/RecentContent.hh>
 #include <emuframework/RewindManager.hh>
+#include <emuframework/FrameHashRecorder.hh>
+#include <emuframework/AVRecorder.hh>
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/MemorySearch.hh>
+#include <emuframework/ContentPrefetcher.hh>
+#include <emuframework/ContentArchiveCache.hh>
 #include <imagine/input/inputDefs.hh>
 #include <imagine/gui/ViewManager.hh>
 #include <imagine/gui/ToastView.hh>
@@ -238,14 +244,19 @@ public:
 	void applyOSNavStyle(IG::ApplicationContext, bool inEmu);
 	void setCPUNeedsLowLatency(IG::ApplicationContext, bool needed);
 	bool advanceFrames(FrameParams, EmuSystemTask *);
+	const EmuSystemTask &systemTask() const { return emuSystemTask; }
 	void runFrames(EmuSystemTaskContext, EmuVideo *, EmuAudio *, int frames);
 	void skipFrames(EmuSystemTaskContext, int frames, EmuAudio *);
 	bool skipForwardFrames(EmuSystemTaskContext, int frames);
 	void notifyWindowPresented();
 	void renderSystemFramebuffer(EmuVideo &);
 	void renderSystemFramebuffer() { renderSystemFramebuffer(video); }
-	bool writeScreenshot(IG::PixmapView, CStringView path);
-	FS::PathString makeNextScreenshotFilename();
+	bool writeScreenshot(IG::PixmapView, CStringView path, ScreenshotFormat = ScreenshotFormat::PNG);
+	FS::PathString makeNextScreenshotFilename(ScreenshotFormat = ScreenshotFormat::PNG);
+	FS::PathString makeNextRecordingFilename();
+	bool startRecording();
+	void stopRecording();
+	bool isRecording() const { return avRecorder.isRecording(); }
 	bool mogaManagerIsActive() const { return bool(mogaManagerPtr); }
 	void setMogaManagerActive(bool on, bool notify);
 	void closeBluetoothConnections();
@@ -256,6 +267,8 @@ public:
 	void setIntendedFrameRate(Window &, FrameTimeConfig);
 	static std::u16string_view mainViewName();
 	void runBenchmarkOneShot(EmuVideo &);
+	void runFrameHashTest();
+	void exitFrameHashTest(std::string_view loadError);
 	void onSelectFileFromPicker(IG::IO, CStringView path, std::string_view displayName,
 		const Input::Event &, EmuSystemCreateParams, ViewAttachParams);
 	void handleOpenFileCommand(CStringView path);
@@ -371,6 +384,11 @@ public:
 	InputManager inputManager;
 	OutputTimingManager outputTimingManager;
 	RewindManager rewindManager{*this};
+	AVRecorder avRecorder;
+	ScreenshotWriter screenshotWriter{*this};
+	MemorySearch memorySearch;
+	ContentArchiveCache archiveCache;
+	ContentPrefetcher contentPrefetcher;
 	ConditionalMember<enableFrameTimeStats, FrameTimeStats> frameTimeStats;
 	[[no_unique_address]] IG::VibrationManager vibrationManager;
 protected:
@@ -389,6 +407,7 @@ public:
 	BluetoothAdapter bluetoothAdapter;
 	RecentContent recentContent;
 	FS::PathString contentSearchPath;
+	FrameHashTestParams frameHashTestParams;
 	std::string userScreenshotPath;
 	Property<IG::PixelFormat, CFGKEY_RENDER_PIXEL_FORMAT,
 		PropertyDesc<IG::PixelFormat>{.isValid = renderPixelFormatIsValid}> renderPixelFormat;
@@ -445,6 +464,13 @@ public:
 		PropertyDesc<Gfx::PresentMode>{.defaultValue = Gfx::PresentMode::Auto, .isValid = enumIsValidUpToLast}> presentMode;
 	ConditionalMember<Gfx::supportsPresentationTime, PresentationTimeMode> presentationTimeMode{PresentationTimeMode::basic};
 	Property<bool, CFGKEY_BLANK_FRAME_INSERTION> allowBlankFrameInsertion;
+	Property<bool, CFGKEY_AUTO_FRAME_DELAY> autoFrameDelay;
+	Property<ScreenshotFormat, CFGKEY_SCREENSHOT_FORMAT,
+		PropertyDesc<ScreenshotFormat>{.isValid = screenshotFormatIsValid}> screenshotFormat;
+	// off by default on mobile devices where the memory is usually more constrained
+	Property<bool, CFGKEY_PREFETCH_CONTENT,
+		PropertyDesc<bool>{.defaultValue = !(Config::envIsAndroid || Config::envIsIOS)}> prefetchesContent;
+	Property<bool, CFGKEY_CACHE_ARCHIVE_CONTENT, PropertyDesc<bool>{.defaultValue = true}> cachesArchiveContent;
 
 protected:
 	struct ConfigParams
@@ -18,6 +18,8 @@
 #include <imagine/audio/OutputStream.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/time/Time.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/util/string/CStringView.hh>
 #include <imagine/util/container/RingBuffer.hh>
 #include <imagine/util/used.hh>
 #include <memory>
@@ -33,6 +35,8 @@ namespace EmuEx
 {
 
 using namespace IG;
+class FrameHashRecorder;
+class AVRecorder;
 
 struct AudioFlags
 {
@@ -73,6 +77,8 @@ public:
 	int8_t maxVolume() const { return std::round(maxVolume_ * 100.f); }
 	void setOutputAPI(IG::Audio::Api);
 	IG::Audio::Api outputAPI() const { return audioAPI; }
+	// uses Api::NULL_SINK or Api::WAV_FILE for this session without changing the saved API
+	void setSinkOutput(IG::Audio::Api, CStringView filePath = {});
 	void setEnabled(bool on);
 	bool isEnabled() const;
 	void setEnabledDuringAltSpeed(bool on);
@@ -95,11 +101,17 @@ protected:
 	float maxVolume_{1.};
 	float currentVolume{1.};
 	std::atomic<AudioWriteState> audioWriteState{AudioWriteState::BUFFER};
+	std::atomic<int64_t> outputLatencyNSecs{};
+	std::atomic_bool outputLatencyChanged{};
 	int8_t channels{2};
 	AudioFlags flags{defaultAudioFlags};
 	ConditionalMember<IG::Audio::Config::MULTIPLE_SYSTEM_APIS, IG::Audio::Api> audioAPI{};
+	IG::Audio::Api sinkAPI{};
+	FS::PathString sinkFilePath;
 	bool addSoundBuffersOnUnderrun{};
 public:
+	FrameHashRecorder *hashRecorder{};
+	AVRecorder *avRecorder{};
 	bool addSoundBuffersOnUnderrunSetting{};
 	int8_t defaultSoundBuffers{3};
 	int8_t soundBuffers{defaultSoundBuffers};
@@ -109,6 +121,7 @@ public:
 	size_t framesCapacity() const;
 	bool shouldStartAudioWrites(size_t bytesToWrite = 0) const;
 	void resizeAudioBuffer(size_t targetBufferFillBytes);
+	void applyOutputLatency();
 	void updateVolume();
 	void updateAddBuffersOnUnderrun();
 };
@@ -84,6 +84,8 @@ enum { CFGKEY_SOUND = 0, CFGKEY_TOUCH_CONTROL_DISPLAY = 1,
 	CFGKEY_RECENT_CONTENT_V2 = 116, CFGKEY_MAX_RECENT_CONTENT = 117,
 	CFGKEY_REWIND_STATES = 118, CFGKEY_REWIND_TIMER_SECS = 119,
 	CFGKEY_FRAME_CLOCK = 120, CFGKEY_INPUT_DEVICE_CONTENT_CONFIGS = 121,
+	CFGKEY_AUTO_FRAME_DELAY = 122, CFGKEY_SCREENSHOT_FORMAT = 123,
+	CFGKEY_PREFETCH_CONTENT = 124, CFGKEY_CACHE_ARCHIVE_CONTENT = 125,
 	// 256+ is reserved
 };
 
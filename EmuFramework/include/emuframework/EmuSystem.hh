@@ -36,6 +36,7 @@ class PixelFormat;
 class IO;
 class FileIO;
 class MapIO;
+class ArchiveIO;
 }
 
 namespace IG::Input
@@ -137,6 +138,16 @@ using FrameTime = Nanoseconds;
 
 constexpr const char *optionUserPathContentToken = ":CONTENT:";
 
+// Emulated memory exposed for RAM search and cheats, address is where data starts in the system's memory map
+struct MemoryRegion
+{
+	std::string_view name;
+	std::span<uint8_t> data;
+	uint32_t address{};
+	// 16-bit words of a big-endian CPU are stored in host byte order, so byte addresses are xor'd with 1
+	bool wordSwapped{};
+};
+
 struct SaveStateFlags
 {
 	uint8_t uncompressed:1{};
@@ -246,7 +257,7 @@ public:
 	bool shouldFastForward() const;
 	FS::FileString contentDisplayNameForPath(CStringView path) const;
 	IG::Rotation contentRotation() const;
-	void addThreadGroupIds(std::vector<ThreadId> &) const;
+	std::span<const MemoryRegion> memoryRegions();
 
 	ApplicationContext appContext() const { return appCtx; }
 	bool isActive() const { return state == State::ACTIVE; }
@@ -347,6 +358,8 @@ public:
 		EmuSystemCreateParams, OnLoadProgressDelegate);
 	void loadContentFromFile(IG::IO, CStringView path, std::string_view displayName,
 		EmuSystemCreateParams, OnLoadProgressDelegate);
+	// returns the first archive entry passing defaultFsFilter, throws if none exist
+	static ArchiveIO findArchiveContent(IG::IO);
 	int updateAudioFramesPerVideoFrame();
 	double frameRate() const { return toHz(frameTime()); }
 	FrameTime scaledFrameTime() const
@@ -262,6 +262,13 @@ IG::Rotation EmuSystem::contentRotation() const
 	return {};
 }
 
+std::span<const MemoryRegion> EmuSystem::memoryRegions()
+{
+	if(&MainSystem::memoryRegions != &EmuSystem::memoryRegions)
+		return static_cast<MainSystem*>(this)->memoryRegions();
+	return {};
+}
+
 void EmuSystem::onStart()
 {
 	if(&MainSystem::onStart != &EmuSystem::onStart)
@@ -274,10 +281,4 @@ void EmuSystem::onStop()
 		static_cast<MainSystem*>(this)->onStop();
 }
 
-void EmuSystem::addThreadGroupIds(std::vector<ThreadId> &ids) const
-{
-	if(&MainSystem::addThreadGroupIds != &EmuSystem::addThreadGroupIds)
-		static_cast<const MainSystem*>(this)->addThreadGroupIds(ids);
-}
-
 }
@@ -19,6 +19,8 @@
 #include <imagine/thread/Thread.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/util/variant.hh>
+#include <array>
+#include <atomic>
 
 namespace EmuEx
 {
@@ -29,6 +31,31 @@ class EmuVideo;
 class EmuAudio;
 class EmuApp;
 
+// Picks how long to wait into the frame interval before running the next frame so input is read
+// closer to when the frame is shown. The delay leaves room for the 95th percentile of recent
+// frame work times plus a safety margin that grows when frames miss their deadline.
+class FrameDelayTuner
+{
+public:
+	SteadyClockTime delay(SteadyClockTime frameTime) const;
+	void addWorkTime(SteadyClockTime, bool missedDeadline);
+	SteadyClockTime workTime() const { return workTimeP95; }
+	void reset() { *this = {}; }
+
+private:
+	static constexpr size_t maxSamples = 64;
+	static constexpr size_t minSamples = 16;
+	static constexpr SteadyClockTime minMargin = Milliseconds{2};
+	static constexpr SteadyClockTime maxMargin = Milliseconds{8};
+	static constexpr int framesToReduceMargin = 120;
+	std::array<SteadyClockTime, maxSamples> samples{};
+	size_t nextSample{};
+	size_t sampleCount{};
+	SteadyClockTime workTimeP95{};
+	SteadyClockTime margin{minMargin};
+	int framesSinceMiss{};
+};
+
 class EmuSystemTask
 {
 public:
@@ -65,8 +92,10 @@ public:
 	void notifyFramePresented();
 	void sendVideoFormatChangedReply(EmuVideo &);
 	void sendFrameFinishedReply(EmuVideo &);
-	void sendScreenshotReply(bool success);
+	void sendScreenshotReply(bool success) const;
 	auto threadId() const { return threadId_; }
+	Microseconds frameDelay() const { return Microseconds{frameDelayUSecs.load(std::memory_order_relaxed)}; }
+	Microseconds frameWorkTime() const { return Microseconds{frameWorkUSecs.load(std::memory_order_relaxed)}; }
 
 private:
 	EmuApp &app;
@@ -74,6 +103,14 @@ private:
 	std::thread taskThread;
 	ThreadId threadId_{};
 	FrameParams frameParams;
+	FrameDelayTuner frameDelayTuner;
+	// latest values from frameDelayTuner for display on the main thread
+	std::atomic_int32_t frameDelayUSecs{};
+	std::atomic_int32_t frameWorkUSecs{};
+	bool missedFrameDeadline{};
+
+	void waitForFrameDelay(const FrameParams &);
+	void updateFrameDelay(const FrameParams &, SteadyClockTimePoint workStart);
 public:
 	bool framePending{};
 };
@@ -27,6 +27,8 @@ namespace EmuEx
 using namespace IG;
 class EmuVideo;
 class EmuSystem;
+class FrameHashRecorder;
+class AVRecorder;
 
 class [[nodiscard]] EmuVideoImage
 {
@@ -68,6 +70,7 @@ public:
 	void clear();
 	void takeGameScreenshot();
 	bool isExternalTexture() const;
+	bool isSingleBuffered() const { return vidImg.isSingleBuffered(); }
 	Gfx::PixmapBufferTexture &image();
 	Gfx::Renderer &renderer() const;
 	IG::ApplicationContext appContext() const;
@@ -95,11 +98,14 @@ protected:
 	Gfx::ColorSpace colSpace{Gfx::ColorSpace::LINEAR};
 	bool useLinearFilter{true};
 
-	void doScreenshot(EmuSystemTaskContext, IG::PixmapView pix);
+	void doScreenshot(IG::PixmapView pix);
+	void recordVideo(IG::PixmapView pix);
 	void postFrameFinished(EmuSystemTaskContext);
 	Gfx::TextureSamplerConfig samplerConfig() const { return samplerConfigForLinearFilter(useLinearFilter); }
 
 public:
+	FrameHashRecorder *hashRecorder{};
+	AVRecorder *avRecorder{};
 	bool isOddField{};
 };
 
@@ -34,7 +34,9 @@ public:
 protected:
 	TextMenuItem savePath;
 	TextMenuItem screenshotPath;
-	StaticArrayList<MenuItem*, 7> item;
+	TextMenuItem screenshotFormatItems[3];
+	MultiChoiceMenuItem screenshotFormat;
+	StaticArrayList<MenuItem*, 8> item;
 
 	void onSavePathChange(std::string_view path);
 };
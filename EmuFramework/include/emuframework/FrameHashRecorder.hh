@@ -0,0 +1,81 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/inputDefs.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/pixmap/Pixmap.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <vector>
+#include <cstdint>
+
+namespace IG
+{
+class ApplicationContext;
+}
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+struct FrameHash
+{
+	uint64_t video{};
+	uint64_t audio{};
+
+	constexpr bool operator==(FrameHash const&) const = default;
+};
+
+struct ScriptedInput
+{
+	int frame{};
+	KeyCode code{};
+	bool pushed{};
+};
+
+struct FrameHashTestParams
+{
+	FS::PathString outputPath;
+	FS::PathString goldenPath;
+	FS::PathString inputPath;
+	int frames{};
+
+	explicit operator bool() const { return frames > 0; }
+};
+
+// Hashes the video and audio output of each emulated frame so runs can be compared bit-exact
+class FrameHashRecorder
+{
+public:
+	void addVideo(PixmapView);
+	void addAudio(const void *samples, size_t bytes);
+	void endFrame();
+	size_t frames() const { return hashes.size(); }
+	bool writeFile(ApplicationContext, CStringView path) const;
+	// returns the first frame not matching the golden file, or -1 if all frames match
+	// and both have the same length
+	int firstMismatchedFrame(ApplicationContext, CStringView goldenPath) const;
+	static std::vector<ScriptedInput> readScriptedInput(ApplicationContext, CStringView path);
+
+private:
+	std::vector<FrameHash> hashes;
+	FrameHash current{};
+	uint64_t lastVideoHash{};
+	bool hasVideo{};
+};
+
+}
@@ -50,6 +50,9 @@ protected:
 	BoolMenuItem showBluetoothScan;
 	BoolMenuItem showHiddenFiles;
 	DualTextMenuItem maxRecentContent;
+	BoolMenuItem prefetchContent;
+	BoolMenuItem cacheArchiveContent;
+	TextMenuItem clearArchiveCache;
 	TextHeadingMenuItem orientationHeading;
 	TextMenuItem menuOrientationItem[5];
 	MultiChoiceMenuItem menuOrientation;
@@ -58,7 +61,7 @@ protected:
 	ConditionalMember<Config::TRANSLUCENT_SYSTEM_UI, BoolMenuItem> layoutBehindSystemUI;
 	ConditionalMember<Config::freeformWindows, TextMenuItem> setWindowSize;
 	ConditionalMember<Config::freeformWindows, TextMenuItem> toggleFullScreen;
-	StaticArrayList<MenuItem*, 23> item;
+	StaticArrayList<MenuItem*, 25> item;
 };
 
 }
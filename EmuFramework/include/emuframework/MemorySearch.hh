@@ -0,0 +1,78 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/EmuSystem.hh>
+#include <imagine/util/enum.hh>
+#include <optional>
+#include <vector>
+#include <cstdint>
+
+namespace EmuEx
+{
+
+WISE_ENUM_CLASS((SearchComparison, uint8_t),
+	Equal,
+	NotEqual,
+	Less,
+	Greater,
+	LessOrEqual,
+	GreaterOrEqual);
+
+// Narrows down the addresses of a value in emulated RAM. Each filter compares every
+// remaining candidate to either a constant or its value at the previous filter, using
+// 16-byte vector compares so even a few MB of RAM is searched in a few milliseconds
+class MemorySearch
+{
+public:
+	struct Result
+	{
+		uint32_t address;
+		uint32_t value;
+	};
+
+	void start(std::span<const MemoryRegion>, uint8_t valueBytes);
+	bool filterByLastValue(std::span<const MemoryRegion> regions, SearchComparison cmp) { return filter(regions, cmp, {}); }
+	// returns false if the value doesn't fit in the search's value size
+	bool filterByValue(std::span<const MemoryRegion> regions, SearchComparison cmp, uint64_t value);
+	bool valueFits(uint64_t value) const { return value <= (uint64_t{1} << (valueBytes_ * 8)) - 1; }
+	std::vector<Result> results(size_t maxResults) const;
+	void clear();
+	bool isActive() const { return regions.size(); }
+	size_t candidateCount() const { return candidates; }
+	uint8_t valueBytes() const { return valueBytes_; }
+
+private:
+	struct RegionState
+	{
+		uint32_t address{};
+		size_t size{};
+		// both padded to the vector size and indexed like the region's data, a value's bytes are all
+		// set while it's a candidate. 32-bit values of word swapped regions have their halves
+		// swapped back so they compare in the emulated CPU's order
+		std::vector<uint8_t> snapshot;
+		std::vector<uint8_t> candidateMask;
+		bool wordSwapped{};
+	};
+
+	std::vector<RegionState> regions;
+	size_t candidates{};
+	uint8_t valueBytes_{1};
+
+	bool filter(std::span<const MemoryRegion>, SearchComparison, std::optional<uint32_t> value);
+};
+
+}
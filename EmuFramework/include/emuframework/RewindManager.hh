@@ -17,7 +17,7 @@
 
 #include <emuframework/config.hh>
 #include <imagine/base/PausableTimer.hh>
-#include <imagine/util/memory/FlexArray.hh>
+#include <memory>
 
 namespace IG
 {
@@ -58,14 +58,20 @@ public:
 	}
 
 private:
-	struct StateEntry
-	{
-		size_t size{};
-		uint8_t data[];
-	};
-
-	FlexArray<StateEntry> stateEntries;
-	size_t stateIdx{};
+	// Saved states are stored as XOR deltas against the following state in a ring buffer of
+	// 32-bit words. A delta is either sparse (word index, xor) pairs or, when half or more of
+	// the state changed, a dense xor of every word, so it's never much larger than a full state.
+	// Each delta starts with its payload size and ends with the restored state's size, a dense
+	// flag, and the payload size again so the ring can be walked from either end. The oldest
+	// deltas are dropped to make room, the ring and the two full states below fit in the
+	// memory of maxStates full states plus a few words per delta
+	std::unique_ptr<uint32_t[]> deltas;
+	size_t deltasCapacity{};
+	size_t deltasTop{};
+	size_t deltasUsed{};
+	std::unique_ptr<uint32_t[]> currState; // most recently saved state
+	std::unique_ptr<uint32_t[]> newState;
+	size_t currStateSize{};
 public:
 	size_t stateSize{};
 	size_t maxStates{};
@@ -73,6 +79,10 @@ public:
 
 private:
 	void saveState(EmuApp &);
+	size_t stateWords() const { return (stateSize + 3) / 4; }
+	void pushDelta();
+	bool popDelta();
+	void dropOldestDelta();
 };
 
 }
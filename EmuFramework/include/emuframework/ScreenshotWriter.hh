@@ -0,0 +1,79 @@
+#pragma once
+
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/util/enum.hh>
+#include <imagine/util/string/CStringView.hh>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace EmuEx
+{
+
+using namespace IG;
+
+class EmuApp;
+
+WISE_ENUM_CLASS((ScreenshotFormat, uint8_t),
+	PNG,
+	FastPNG,
+	QOI);
+
+constexpr bool screenshotFormatIsValid(const auto &v)
+{
+	// Android's encoder has no compression level setting
+	if(Config::envIsAndroid && v == ScreenshotFormat::FastPNG)
+		return false;
+	return enumIsValidUpToLast(v);
+}
+
+// Encodes and writes screenshots on a background thread so the emulation thread
+// only pays for copying the frame into a pooled buffer
+class ScreenshotWriter
+{
+public:
+	ScreenshotWriter(EmuApp &app): app{app} {}
+	~ScreenshotWriter();
+	bool write(PixmapView, FS::PathString path, ScreenshotFormat);
+	// true if a queued or in progress screenshot will be written to the path
+	bool isPending(CStringView path);
+
+private:
+	struct Job
+	{
+		MemPixmap pixmap;
+		FS::PathString path;
+		ScreenshotFormat format{};
+	};
+
+	EmuApp &app;
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable jobCond;
+	std::deque<Job> jobs; // the front job stays queued while it's written
+	std::vector<MemPixmap> pool;
+	bool quitting{};
+
+	void run();
+};
+
+}
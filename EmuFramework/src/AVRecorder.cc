@@ -0,0 +1,349 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/AVRecorder.hh>
+#include <imagine/thread/ThreadRegistry.hh>
+#include <imagine/logger/logger.h>
+#include <array>
+#include <cmath>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"AVRecorder"};
+constexpr size_t videoPoolSize = 8;
+constexpr size_t audioPoolSize = 32;
+// stay well under the 32-bit RIFF size limit, leaving room for the index
+constexpr uint64_t maxMoviBytes = 0xF0000000;
+constexpr uint32_t keyframeFlag = 0x10; // AVIIF_KEYFRAME
+constexpr auto videoPixelFormat = PixelFmtBGRA8888; // matches 32-bit BI_RGB byte order
+
+static constexpr uint32_t fourCC(const char (&s)[5])
+{
+	return uint32_t(uint8_t(s[0])) | uint32_t(uint8_t(s[1])) << 8 | uint32_t(uint8_t(s[2])) << 16 | uint32_t(uint8_t(s[3])) << 24;
+}
+
+bool AVRecorder::start(FileIO file_, WSize frameSize_, Nanoseconds frameTime, Audio::Format audioFormat_)
+{
+	stop();
+	if(!file_)
+		return false;
+	frameSize = frameSize_;
+	audioFormat = audioFormat_;
+	file = std::move(file_);
+	if(!writeHeader(frameTime))
+	{
+		log.error("error writing header");
+		file = {};
+		return false;
+	}
+	index.clear();
+	moviBytes = 0;
+	videoFrames = audioFrames = 0;
+	fileFull = false;
+	droppedFrames = droppedAudioPackets = 0;
+	pendingDroppedFrames = 0;
+	stopReason_ = StopReason::none;
+	stopPending = false;
+	quitting = false;
+	videoPool.assign(videoPoolSize, std::vector<uint8_t>(PixmapDesc{frameSize, videoPixelFormat}.bytes()));
+	audioPool.resize(audioPoolSize);
+	for(auto &buff : audioPool)
+	{
+		buff.reserve(audioFormat.timeToBytes(frameTime) * 2);
+	}
+	thread = std::thread{[this]{ run(); }};
+	log.info("started recording {}x{} video", frameSize.x, frameSize.y);
+	return true;
+}
+
+void AVRecorder::stop()
+{
+	if(!isRecording())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quitting = true;
+	}
+	queueCond.notify_one();
+	thread.join();
+	finishFile();
+	std::scoped_lock lock{mutex};
+	queue.clear();
+	videoPool.clear();
+	audioPool.clear();
+	if(droppedFrames || droppedAudioPackets)
+		log.warn("dropped {} video frames and {} audio packets while recording", droppedFrames, droppedAudioPackets);
+}
+
+bool AVRecorder::addVideo(PixmapView pix)
+{
+	if(stopPending) [[unlikely]]
+		return true;
+	if(pix.size() != frameSize) [[unlikely]]
+	{
+		// the AVI stream has a fixed size, end the file at the last matching frame
+		log.error("frame size changed from {}x{} to {}x{}", frameSize.x, frameSize.y, pix.w(), pix.h());
+		setStopReason(StopReason::frameSizeChanged);
+	}
+	if(stopReason() != StopReason::none) [[unlikely]]
+	{
+		stopPending = true;
+		return false;
+	}
+	Packet packet{.type = ChunkType::video};
+	if(!takeBuffer(videoPool, packet.data)) [[unlikely]]
+	{
+		pendingDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+		return true;
+	}
+	MutablePixmapView{{frameSize, videoPixelFormat}, packet.data.data()}.writeConverted(pix);
+	submit(std::move(packet));
+	return true;
+}
+
+void AVRecorder::addAudio(const void *samples, size_t bytes)
+{
+	if(stopPending) [[unlikely]]
+		return;
+	Packet packet{.type = ChunkType::audio};
+	if(!takeBuffer(audioPool, packet.data)) [[unlikely]]
+	{
+		std::scoped_lock lock{mutex};
+		droppedAudioPackets++;
+		return;
+	}
+	auto sampleBytes = static_cast<const uint8_t*>(samples);
+	packet.data.assign(sampleBytes, sampleBytes + bytes);
+	submit(std::move(packet));
+}
+
+bool AVRecorder::takeBuffer(std::vector<std::vector<uint8_t>> &pool, std::vector<uint8_t> &buff)
+{
+	std::scoped_lock lock{mutex};
+	if(pool.empty())
+		return false;
+	buff = std::move(pool.back());
+	pool.pop_back();
+	return true;
+}
+
+void AVRecorder::submit(Packet packet)
+{
+	{
+		std::scoped_lock lock{mutex};
+		queue.emplace_back(std::move(packet));
+	}
+	queueCond.notify_one();
+}
+
+void AVRecorder::setStopReason(StopReason reason)
+{
+	// keep the first reason if several happen before the recording is stopped
+	auto expected = StopReason::none;
+	stopReason_.compare_exchange_strong(expected, reason, std::memory_order_relaxed);
+}
+
+void AVRecorder::run()
+{
+	auto registration = helperThreads().registerThisThread("AV Recorder", ThreadRole::background);
+	for(;;)
+	{
+		Packet packet;
+		{
+			std::unique_lock lock{mutex};
+			queueCond.wait(lock, [&]{ return queue.size() || quitting; });
+			if(queue.empty())
+				return;
+			packet = std::move(queue.front());
+			queue.pop_front();
+		}
+		if(packet.type == ChunkType::video)
+		{
+			auto dropped = pendingDroppedFrames.exchange(0, std::memory_order_relaxed);
+			for(auto i = dropped; i; i--)
+			{
+				// empty chunks keep the frame count in sync with the audio
+				writeChunk(ChunkType::video, {});
+			}
+			writeChunk(ChunkType::video, packet.data);
+			std::scoped_lock lock{mutex};
+			droppedFrames += dropped;
+			videoPool.emplace_back(std::move(packet.data));
+		}
+		else
+		{
+			writeChunk(ChunkType::audio, packet.data);
+			std::scoped_lock lock{mutex};
+			audioPool.emplace_back(std::move(packet.data));
+		}
+	}
+}
+
+void AVRecorder::writeChunk(ChunkType type, std::span<const uint8_t> data)
+{
+	if(fileFull) [[unlikely]]
+		return;
+	const uint32_t paddedSize = data.size() + (data.size() & 1);
+	if(moviBytes + 8 + paddedSize > maxMoviBytes) [[unlikely]]
+	{
+		log.warn("reached maximum AVI size, ignoring further data");
+		fileFull = true;
+		setStopReason(StopReason::fileFull);
+		return;
+	}
+	const std::array<uint32_t, 2> chunkHeader{type == ChunkType::video ? fourCC("00db") : fourCC("01wb"), uint32_t(data.size())};
+	const uint8_t pad{};
+	const std::array<OutVector, 3> vecs
+	{
+		std::span<const uint32_t>{chunkHeader},
+		data,
+		std::span<const uint8_t>{&pad, paddedSize - data.size()},
+	};
+	if(file.writeVector(vecs) != ssize_t(8 + paddedSize)) [[unlikely]]
+	{
+		log.error("error writing chunk, stopping writes");
+		fileFull = true;
+		setStopReason(StopReason::writeError);
+		return;
+	}
+	// offsets are relative to the movi list type
+	index.emplace_back(chunkHeader[0], keyframeFlag, uint32_t(4 + moviBytes), chunkHeader[1]);
+	moviBytes += 8 + paddedSize;
+	if(type == ChunkType::video)
+		videoFrames++;
+	else
+		audioFrames += audioFormat.bytesToFrames(data.size());
+}
+
+bool AVRecorder::writeHeader(Nanoseconds frameTime)
+{
+	std::vector<uint8_t> hdr;
+	auto put32 = [&](uint32_t v) { hdr.insert(hdr.end(), {uint8_t(v), uint8_t(v >> 8), uint8_t(v >> 16), uint8_t(v >> 24)}); };
+	auto put16 = [&](uint16_t v) { hdr.insert(hdr.end(), {uint8_t(v), uint8_t(v >> 8)}); };
+	auto putFourCC = [&](const char (&s)[5]) { put32(fourCC(s)); };
+	auto beginChunk = [&](const char (&id)[5]) { putFourCC(id); put32(0); return hdr.size(); };
+	auto endChunk = [&](size_t dataOffset)
+	{
+		uint32_t size = hdr.size() - dataOffset;
+		std::copy_n(reinterpret_cast<const uint8_t*>(&size), 4, &hdr[dataOffset - 4]);
+	};
+	const uint32_t frameBytes = PixmapDesc{frameSize, videoPixelFormat}.bytes();
+	const uint32_t usecsPerFrame = duration_cast<Microseconds>(frameTime).count();
+	// frame rate as rate/scale with enough precision for rates like 59.94
+	const uint32_t videoScale = 1000;
+	const uint32_t videoRate = std::round(1e12 / frameTime.count());
+	const uint16_t blockAlign = audioFormat.bytesPerFrame();
+	const uint32_t audioBytesPerSec = audioFormat.rate * blockAlign;
+	putFourCC("RIFF"); put32(0); putFourCC("AVI ");
+	auto hdrl = beginChunk("LIST");
+	putFourCC("hdrl");
+	{
+		auto avih = beginChunk("avih");
+		put32(usecsPerFrame);
+		put32(frameBytes * (1000000 / std::max(usecsPerFrame, 1u)) + audioBytesPerSec);
+		put32(0);
+		put32(keyframeFlag); // AVIF_HASINDEX
+		headerOffsets.totalFrames = hdr.size();
+		put32(0);
+		put32(0);
+		put32(2);
+		put32(frameBytes);
+		put32(frameSize.x);
+		put32(frameSize.y);
+		for(auto i = 0; i < 4; i++) { put32(0); }
+		endChunk(avih);
+	}
+	{
+		auto strl = beginChunk("LIST");
+		putFourCC("strl");
+		auto strh = beginChunk("strh");
+		putFourCC("vids");
+		put32(0); put32(0); put32(0); put32(0);
+		put32(videoScale);
+		put32(videoRate);
+		put32(0);
+		headerOffsets.videoLength = hdr.size();
+		put32(0);
+		put32(frameBytes);
+		put32(-1);
+		put32(0);
+		put16(0); put16(0); put16(frameSize.x); put16(frameSize.y);
+		endChunk(strh);
+		auto strf = beginChunk("strf");
+		put32(40);
+		put32(frameSize.x);
+		put32(-frameSize.y); // negative height for top-down rows
+		put16(1);
+		put16(32);
+		put32(0); // BI_RGB
+		put32(frameBytes);
+		put32(0); put32(0); put32(0); put32(0);
+		endChunk(strf);
+		endChunk(strl);
+	}
+	{
+		auto strl = beginChunk("LIST");
+		putFourCC("strl");
+		auto strh = beginChunk("strh");
+		putFourCC("auds");
+		put32(0); put32(0); put32(0); put32(0);
+		put32(blockAlign);
+		put32(audioBytesPerSec);
+		put32(0);
+		headerOffsets.audioLength = hdr.size();
+		put32(0);
+		put32(0);
+		put32(-1);
+		put32(blockAlign);
+		put16(0); put16(0); put16(0); put16(0);
+		endChunk(strh);
+		auto strf = beginChunk("strf");
+		put16(audioFormat.sample.isFloat() ? 3 : 1); // IEEE float or integer PCM
+		put16(audioFormat.channels);
+		put32(audioFormat.rate);
+		put32(audioBytesPerSec);
+		put16(blockAlign);
+		put16(audioFormat.sample.bytes() * 8);
+		put16(0);
+		endChunk(strf);
+		endChunk(strl);
+	}
+	endChunk(hdrl);
+	putFourCC("LIST");
+	put32(0);
+	headerOffsets.movi = hdr.size();
+	putFourCC("movi");
+	return file.write(hdr.data(), hdr.size()) == ssize_t(hdr.size());
+}
+
+void AVRecorder::finishFile()
+{
+	const uint32_t indexBytes = index.size() * sizeof(IndexEntry);
+	const std::array<uint32_t, 2> indexHeader{fourCC("idx1"), indexBytes};
+	file.write(std::span<const uint32_t>{indexHeader});
+	file.write(std::span<const IndexEntry>{index});
+	const uint32_t moviListSize = 4 + moviBytes;
+	file.put(moviListSize, headerOffsets.movi - 4);
+	file.put(uint32_t(headerOffsets.movi + moviListSize + 8 + indexBytes - 8), 4);
+	file.put(videoFrames, headerOffsets.totalFrames);
+	file.put(videoFrames, headerOffsets.videoLength);
+	file.put(audioFrames, headerOffsets.audioLength);
+	log.info("finished recording with {} video frames and {} audio frames", videoFrames, audioFrames);
+	file = {};
+	index = {};
+}
+
+}
@@ -96,6 +96,10 @@ void EmuApp::saveConfigFile(FileIO &io)
 	if(overrideScreenFrameRate)
 		writeOptionValue(io, CFGKEY_OVERRIDE_SCREEN_FRAME_RATE, overrideScreenFrameRate);
 	writeOptionValueIfNotDefault(io, allowBlankFrameInsertion);
+	writeOptionValueIfNotDefault(io, autoFrameDelay);
+	writeOptionValueIfNotDefault(io, screenshotFormat);
+	writeOptionValueIfNotDefault(io, prefetchesContent);
+	writeOptionValueIfNotDefault(io, cachesArchiveContent);
 	if(Config::Bluetooth::scanCache && !bluetoothAdapter.useScanCache)
 		writeOptionValue(io, CFGKEY_BLUETOOTH_SCAN_CACHE, false);
 	writeOptionValueIfNotDefault(io, cpuAffinityMask);
@@ -224,6 +228,10 @@ EmuApp::ConfigParams EmuApp::loadConfigFile(IG::ApplicationContext ctx)
 				case CFGKEY_SHOW_HIDDEN_FILES: return readOptionValue(io, showHiddenFilesInPicker);
 				case CFGKEY_OVERRIDE_SCREEN_FRAME_RATE: return readOptionValue(io, overrideScreenFrameRate);
 				case CFGKEY_BLANK_FRAME_INSERTION: return readOptionValue(io, allowBlankFrameInsertion);
+				case CFGKEY_AUTO_FRAME_DELAY: return readOptionValue(io, autoFrameDelay);
+				case CFGKEY_SCREENSHOT_FORMAT: return readOptionValue(io, screenshotFormat);
+				case CFGKEY_PREFETCH_CONTENT: return readOptionValue(io, prefetchesContent);
+				case CFGKEY_CACHE_ARCHIVE_CONTENT: return readOptionValue(io, cachesArchiveContent);
 				case CFGKEY_CONTENT_ROTATION: return readOptionValue(io, contentRotation);
 				case CFGKEY_VIDEO_LANDSCAPE_ASPECT_RATIO: return readOptionValue(io, videoLayer.landscapeAspectRatio, isValidAspectRatio);
 				case CFGKEY_VIDEO_PORTRAIT_ASPECT_RATIO: return readOptionValue(io, videoLayer.portraitAspectRatio, isValidAspectRatio);
@@ -0,0 +1,247 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ContentArchiveCache.hh>
+#include <emuframework/Option.hh>
+#include <imagine/io/ArchiveIO.hh>
+#include <imagine/fs/FS.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ArchiveCache"};
+constexpr uint32_t indexVersion = 1;
+
+static uint64_t fnv1a(uint64_t hash, std::span<const char> data)
+{
+	for(auto c : data)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+static int64_t nowSecs()
+{
+	return std::chrono::duration_cast<std::chrono::seconds>(WallClock::now().time_since_epoch()).count();
+}
+
+ContentArchiveCache::ContentArchiveCache(ApplicationContext ctx):
+	ctx{ctx}
+{
+	auto cachePath = ctx.cachePath();
+	if(cachePath.empty())
+		return;
+	dir = FS::pathString(cachePath, "archiveContent");
+	if(!FS::exists(dir) && !FS::create_directory(dir))
+	{
+		log.error("can't create cache directory:{}", dir);
+		dir.clear();
+		return;
+	}
+	readIndex();
+}
+
+uint64_t ContentArchiveCache::archiveKey(CStringView path, size_t archiveSize) const
+{
+	int64_t mtime = ctx.fileUriLastWriteTime(path).time_since_epoch().count();
+	uint64_t size = archiveSize;
+	auto hash = fnv1a(0xcbf29ce484222325, std::string_view{path});
+	hash = fnv1a(hash, {reinterpret_cast<const char*>(&size), sizeof(size)});
+	return fnv1a(hash, {reinterpret_cast<const char*>(&mtime), sizeof(mtime)});
+}
+
+FileIO ContentArchiveCache::open(uint64_t key, FS::FileString &nameOut)
+{
+	std::scoped_lock lock{mutex};
+	auto it = std::ranges::find(entries, key, &Entry::key);
+	if(it == entries.end())
+		return {};
+	FileIO io{entryPath(*it), {.test = true, .accessHint = IOAccessHint::All}};
+	if(!io || io.size() != it->size)
+	{
+		log.warn("dropping stale entry:{}", it->name);
+		removeEntry(it);
+		writeIndex();
+		return {};
+	}
+	log.info("using cached entry:{} ({} bytes)", it->name, it->size);
+	nameOut = it->name;
+	it->lastUse = nowSecs();
+	writeIndex();
+	return io;
+}
+
+FileIO ContentArchiveCache::add(uint64_t key, ArchiveIO &entry)
+{
+	std::scoped_lock lock{mutex};
+	if(auto it = std::ranges::find(entries, key, &Entry::key);
+		it != entries.end())
+	{
+		removeEntry(it);
+	}
+	Entry newEntry{key, nowSecs(), entry.size(), entry.crc32(), FS::FileString{entry.name()}};
+	if(!canStore(newEntry.size))
+		return {};
+	evict(newEntry.size);
+	auto path = entryPath(newEntry);
+	FS::PathString tempPath{path};
+	tempPath += ".tmp";
+	{
+		FileIO out{tempPath, OpenFlags::testNewFile()};
+		if(!out)
+		{
+			log.error("can't create:{}", tempPath);
+			return {};
+		}
+		constexpr size_t bufferSize = 0x40000;
+		auto buff = std::make_unique<uint8_t[]>(bufferSize);
+		uint64_t written{};
+		while(written < newEntry.size)
+		{
+			auto bytes = entry.read(buff.get(), std::min(uint64_t(bufferSize), newEntry.size - written));
+			if(bytes <= 0 || out.write(buff.get(), bytes) != bytes)
+			{
+				log.error("error extracting {} to cache", newEntry.name);
+				out = {};
+				FS::remove(tempPath);
+				return {};
+			}
+			written += bytes;
+		}
+	}
+	if(!FS::rename(tempPath, path))
+	{
+		FS::remove(tempPath);
+		return {};
+	}
+	log.info("cached entry:{} ({} bytes)", newEntry.name, newEntry.size);
+	entries.emplace_back(std::move(newEntry));
+	writeIndex();
+	return {path, {.test = true, .accessHint = IOAccessHint::All}};
+}
+
+uint64_t ContentArchiveCache::clear()
+{
+	if(dir.empty())
+		return 0;
+	std::scoped_lock lock{mutex};
+	auto freedSize = entriesSize();
+	for(const auto &e : entries) { FS::remove(entryPath(e)); }
+	entries.clear();
+	writeIndex();
+	log.info("cleared {} bytes", freedSize);
+	return freedSize;
+}
+
+uint64_t ContentArchiveCache::totalSize() const
+{
+	std::scoped_lock lock{mutex};
+	return entriesSize();
+}
+
+uint64_t ContentArchiveCache::entriesSize() const
+{
+	uint64_t size{};
+	for(const auto &e : entries) { size += e.size; }
+	return size;
+}
+
+FS::PathString ContentArchiveCache::entryPath(const Entry &e) const
+{
+	return FS::pathString(dir, format<FS::FileString>("{:016x}-{:08x}", e.key, e.crc));
+}
+
+void ContentArchiveCache::removeEntry(std::vector<Entry>::iterator it)
+{
+	FS::remove(entryPath(*it));
+	entries.erase(it);
+}
+
+void ContentArchiveCache::evict(size_t neededSize)
+{
+	auto newTotalSize = entriesSize() + neededSize;
+	while(newTotalSize > maxSize && entries.size())
+	{
+		auto it = std::ranges::min_element(entries, {}, &Entry::lastUse);
+		log.info("evicting:{} ({} bytes)", it->name, it->size);
+		newTotalSize -= it->size;
+		removeEntry(it);
+	}
+}
+
+void ContentArchiveCache::readIndex()
+{
+	FileIO io{FS::pathString(dir, "index"), {.test = true}};
+	if(!io)
+		return;
+	if(io.get<uint32_t>() != indexVersion)
+	{
+		log.warn("ignoring index with unknown version");
+		return;
+	}
+	auto count = io.get<uint32_t>();
+	entries.reserve(std::min(count, 1024u));
+	for(auto i : iotaCount(count))
+	{
+		Entry e;
+		e.key = io.get<uint64_t>();
+		e.lastUse = io.get<int64_t>();
+		e.size = io.get<uint64_t>();
+		e.crc = io.get<uint32_t>();
+		if(readSizedData<uint16_t>(io, e.name) <= 0)
+		{
+			log.error("truncated index at entry:{}", i);
+			break;
+		}
+		entries.emplace_back(std::move(e));
+	}
+}
+
+void ContentArchiveCache::writeIndex() const
+{
+	auto path = FS::pathString(dir, "index");
+	FS::PathString tempPath{path};
+	tempPath += ".tmp";
+	{
+		FileIO io{tempPath, OpenFlags::testNewFile()};
+		if(!io)
+		{
+			log.error("can't write index");
+			return;
+		}
+		io.put(indexVersion);
+		io.put(uint32_t(entries.size()));
+		for(const auto &e : entries)
+		{
+			io.put(e.key);
+			io.put(e.lastUse);
+			io.put(e.size);
+			io.put(e.crc);
+			writeSizedData<uint16_t>(io, e.name);
+		}
+	}
+	FS::rename(tempPath, path);
+}
+
+}
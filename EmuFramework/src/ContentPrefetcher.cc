@@ -0,0 +1,205 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ContentPrefetcher.hh>
+#include <emuframework/ContentArchiveCache.hh>
+#include <emuframework/EmuApp.hh>
+#include <emuframework/EmuSystem.hh>
+#include <imagine/io/ArchiveIO.hh>
+#include <imagine/thread/ThreadRegistry.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <memory>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ContentPrefetcher"};
+
+ContentPrefetcher::~ContentPrefetcher()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quitting = true;
+	}
+	requestCond.notify_one();
+	thread.join();
+}
+
+void ContentPrefetcher::prefetch(CStringView path, std::string_view displayName)
+{
+	if(!EmuSystem::handlesGenericIO || path.empty())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		if(std::string_view{lastRequestPath} == std::string_view{path})
+			return;
+		lastRequestPath = path;
+		requestPath = path;
+		requestName = displayName;
+		requestUsesArchiveCache = EmuApp::get(ctx).cachesArchiveContent;
+		if(!thread.joinable())
+			thread = std::thread{[this]{ run(); }};
+	}
+	requestCond.notify_one();
+}
+
+IO ContentPrefetcher::take(CStringView path, FS::FileString &nameOut)
+{
+	Entry entry;
+	{
+		std::scoped_lock lock{mutex};
+		requestPath.clear();
+		lastRequestPath.clear();
+		generation++;
+		auto it = std::ranges::find_if(entries, [&](const Entry &e){ return std::string_view{e.path} == std::string_view{path}; });
+		if(it != entries.end())
+			entry = std::move(*it);
+		entries.clear();
+	}
+	if(entry.data.empty())
+		return {};
+	if(entry.lastWriteTime != ctx.fileUriLastWriteTime(path))
+	{
+		log.warn("dropping stale entry:{}", path);
+		return {};
+	}
+	log.info("using prefetched content:{} size:{}", path, entry.data.size());
+	nameOut = entry.name;
+	return IO{std::move(entry.data)};
+}
+
+void ContentPrefetcher::clear()
+{
+	std::scoped_lock lock{mutex};
+	requestPath.clear();
+	lastRequestPath.clear();
+	generation++;
+	entries.clear();
+}
+
+void ContentPrefetcher::run()
+{
+	auto registration = helperThreads().registerThisThread("Content Prefetcher", ThreadRole::background);
+	for(;;)
+	{
+		FS::PathString path;
+		FS::FileString displayName;
+		bool usesArchiveCache;
+		uint32_t startGeneration;
+		{
+			std::unique_lock lock{mutex};
+			requestCond.wait(lock, [&]{ return requestPath.size() || quitting; });
+			if(quitting)
+				return;
+			path = std::exchange(requestPath, {});
+			displayName = std::exchange(requestName, {});
+			usesArchiveCache = requestUsesArchiveCache;
+			startGeneration = generation;
+		}
+		auto lastWriteTime = ctx.fileUriLastWriteTime(path);
+		{
+			std::scoped_lock lock{mutex};
+			if(std::ranges::any_of(entries, [&](const Entry &e){ return e.path == path && e.lastWriteTime == lastWriteTime; }))
+				continue;
+		}
+		auto entry = read(path, displayName, lastWriteTime, usesArchiveCache);
+		if(entry.data.empty())
+			continue;
+		std::scoped_lock lock{mutex};
+		if(generation != startGeneration)
+		{
+			log.info("cache cleared while reading:{}", path);
+			continue;
+		}
+		std::erase_if(entries, [&](const Entry &e){ return e.path == path; });
+		while(entries.size() && (entries.size() == maxEntries || totalSize() + entry.data.size() > maxSize))
+		{
+			log.info("evicting entry:{}", entries.front().path);
+			entries.erase(entries.begin());
+		}
+		log.info("prefetched:{} size:{}", path, entry.data.size());
+		entries.emplace_back(std::move(entry));
+	}
+}
+
+static IOBuffer readAll(auto &io)
+{
+	auto size = io.size();
+	if(!size || size > ContentPrefetcher::maxSize)
+	{
+		log.info("skipping content with size:{}", size);
+		return {};
+	}
+	auto buff = std::make_unique<uint8_t[]>(size);
+	if(io.read(buff.get(), size) != ssize_t(size))
+		return {};
+	return {std::move(buff), size};
+}
+
+ContentPrefetcher::Entry ContentPrefetcher::read(CStringView path, std::string_view displayName,
+	WallClockTimePoint lastWriteTime, bool usesArchiveCache) const
+{
+	try
+	{
+		auto file = ctx.openFileUri(path, {.test = true, .accessHint = IOAccessHint::Sequential});
+		if(!file)
+			return {};
+		if(!EmuSystem::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
+		{
+			if(usesArchiveCache)
+			{
+				addToArchiveCache(path, std::move(file));
+				return {};
+			}
+			auto entry = EmuSystem::findArchiveContent(std::move(file));
+			return {FS::PathString{path}, FS::FileString{entry.name()}, lastWriteTime, readAll(entry)};
+		}
+		return {FS::PathString{path}, {}, lastWriteTime, readAll(file)};
+	}
+	catch(std::exception &err)
+	{
+		log.warn("error reading {}:{}", path, err.what());
+		return {};
+	}
+}
+
+void ContentPrefetcher::addToArchiveCache(CStringView path, IO file) const
+{
+	auto key = archiveCache.archiveKey(path, file.size());
+	if(FS::FileString name; auto io = archiveCache.open(key, name))
+	{
+		// already extracted, just start reading it into the page cache
+		io.advise(0, io.size(), IOAdvice::WillNeed);
+		return;
+	}
+	auto entry = EmuSystem::findArchiveContent(std::move(file));
+	if(!archiveCache.canStore(entry.size()))
+		return;
+	if(archiveCache.add(key, entry))
+		log.info("extracted {} to archive cache", entry.name());
+}
+
+size_t ContentPrefetcher::totalSize() const
+{
+	size_t size{};
+	for(const auto &e : entries)
+		size += e.data.size();
+	return size;
+}
+
+}
@@ -49,9 +49,11 @@
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
 #include <imagine/thread/Thread.hh>
+#include <imagine/thread/ThreadRegistry.hh>
 #include <imagine/bluetooth/BluetoothInputDevice.hh>
 #include <imagine/input/android/MogaManager.hh>
 #include <cmath>
+#include <cstdlib>
 
 namespace EmuEx
 {
@@ -95,6 +97,8 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 	audio{ctx},
 	videoLayer{video, defaultVideoAspectRatio()},
 	inputManager{ctx},
+	archiveCache{ctx},
+	contentPrefetcher{ctx, archiveCache},
 	vibrationManager{ctx},
 	pixmapReader{ctx},
 	pixmapWriter{ctx},
@@ -122,6 +126,15 @@ EmuApp::EmuApp(ApplicationInitParams initParams, ApplicationContext &ctx):
 			[](auto &) {}
 		});
 	};
+	helperThreads().setOnChange([this]
+	{
+		// a frame thread started or exited while emulating, rebuild the session so its thread list matches
+		runOnMainThread([this](ApplicationContext)
+		{
+			if(perfHintSession)
+				applyCPUAffinity(true);
+		});
+	});
 	initOptions(ctx);
 }
 
@@ -216,9 +229,11 @@ void EmuApp::closeSystem()
 {
 	showUI();
 	emuSystemTask.stop();
+	stopRecording();
 	system().closeRuntimeSystem(*this);
 	autosaveManager.resetSlot();
 	rewindManager.clear();
+	memorySearch.clear();
 	viewController().onSystemClosed();
 }
 
@@ -263,14 +278,35 @@ void EmuApp::showExitAlert(ViewAttachParams attach, const Input::Event &e)
 		attach, system().hasContent()), e, false);
 }
 
-static const char *parseCommandArgs(IG::CommandArgs arg)
+static const char *parseCommandArgs(IG::CommandArgs arg, FrameHashTestParams &hashTest, EmuAudio &audio)
 {
-	if(arg.c < 2)
+	const char *launchPath{};
+	for(int i = 1; i < arg.c; i++)
 	{
-		return nullptr;
+		std::string_view argStr{arg.v[i]};
+		auto optionValue = [&](std::string_view name) -> std::optional<std::string_view>
+		{
+			if(!argStr.starts_with(name))
+				return {};
+			return argStr.substr(name.size());
+		};
+		if(auto v = optionValue("--frame-hash-test="))
+			hashTest.frames = std::max(0, std::atoi(v->data())); // substring of a null-terminated arg
+		else if(auto v = optionValue("--frame-hash-output="))
+			hashTest.outputPath = *v;
+		else if(auto v = optionValue("--frame-hash-golden="))
+			hashTest.goldenPath = *v;
+		else if(auto v = optionValue("--frame-hash-input="))
+			hashTest.inputPath = *v;
+		else if(argStr == "--audio-sink=null")
+			audio.setSinkOutput(Audio::Api::NULL_SINK);
+		else if(auto v = optionValue("--audio-sink=wav:"))
+			audio.setSinkOutput(Audio::Api::WAV_FILE, v->data()); // substring of a null-terminated arg
+		else if(!launchPath)
+			launchPath = arg.v[i];
 	}
-	auto launchPath = arg.v[1];
-	log.info("starting content from command line:{}", launchPath);
+	if(launchPath)
+		log.info("starting content from command line:{}", launchPath);
 	return launchPath;
 }
 
@@ -384,7 +420,7 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 	system().onOptionsLoaded();
 	loadSystemOptions();
 	updateLegacySavePathOnStoragePath(ctx, system());
-	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs()));
+	system().setInitialLoadPath(parseCommandArgs(initParams.commandArgs(), frameHashTestParams, audio));
 	audio.manager.setMusicVolumeControlHint();
 	if(!renderer.supportsColorSpace())
 		windowDrawableConfig.colorSpace = {};
@@ -605,7 +641,20 @@ void EmuApp::mainInitCommon(IG::ApplicationInitParams initParams, IG::Applicatio
 				launchPathStr.size())
 			{
 				system().setInitialLoadPath("");
-				handleOpenFileCommand(launchPathStr);
+				if(frameHashTestParams)
+				{
+					createSystemWithMedia({}, launchPathStr, ctx.fileUriDisplayName(launchPathStr),
+						Input::KeyEvent{}, {}, attachParams(), [this](const Input::Event &){ runFrameHashTest(); });
+				}
+				else
+				{
+					handleOpenFileCommand(launchPathStr);
+				}
+			}
+			else if(prefetchesContent && recentContent.size())
+			{
+				// warm the most recently played content since it's the likeliest to be opened
+				contentPrefetcher.prefetch(recentContent.begin()->path, recentContent.begin()->name);
 			}
 
 			win.show();
@@ -803,6 +852,55 @@ void EmuApp::runBenchmarkOneShot(EmuVideo &video)
 	postMessage(2, 0, std::format("{:.2f} fps", 180. / timeSecs.count()));
 }
 
+void EmuApp::runFrameHashTest()
+{
+	auto &params = frameHashTestParams;
+	log.info("starting frame hash test for {} frames", params.frames);
+	auto ctx = appContext();
+	auto inputs = params.inputPath.size() ? FrameHashRecorder::readScriptedInput(ctx, params.inputPath) : std::vector<ScriptedInput>{};
+	FrameHashRecorder recorder;
+	video.setTextureBufferMode(system(), Gfx::TextureBufferMode::HEADLESS);
+	video.hashRecorder = &recorder;
+	audio.hashRecorder = &recorder;
+	system().configFrameTime(audio.format().rate, system().frameTime());
+	auto inputIt = inputs.begin();
+	for(auto frame : iotaCount(params.frames))
+	{
+		for(; inputIt != inputs.end() && inputIt->frame <= frame; ++inputIt)
+		{
+			system().handleInputAction(this, {inputIt->code, {}, inputIt->pushed ? Input::Action::PUSHED : Input::Action::RELEASED});
+		}
+		system().runFrame({}, &video, &audio);
+		recorder.endFrame();
+	}
+	video.hashRecorder = {};
+	audio.hashRecorder = {};
+	int exitCode{};
+	if(params.outputPath.size() && !recorder.writeFile(ctx, params.outputPath))
+		exitCode = 1;
+	if(params.goldenPath.size())
+	{
+		if(auto frame = recorder.firstMismatchedFrame(ctx, params.goldenPath); frame != -1)
+		{
+			log.error("output differs from golden file starting at frame:{}", frame);
+			exitCode = 1;
+		}
+		else
+		{
+			log.info("output matches golden file");
+		}
+	}
+	autosaveManager.resetSlot(noAutosaveName);
+	closeSystem();
+	ctx.exit(exitCode);
+}
+
+void EmuApp::exitFrameHashTest(std::string_view loadError)
+{
+	log.error("frame hash test content failed to load:{}", loadError);
+	appContext().exit(1);
+}
+
 void EmuApp::showEmulation()
 {
 	if(viewController().isShowingEmulation() || !system().hasContent())
@@ -949,6 +1047,11 @@ void EmuApp::createSystemWithMedia(IO io, CStringView path, std::string_view dis
 	assert(strlen(path));
 	if(!EmuApp::hasArchiveExtension(displayName) && !EmuSystem::defaultFsFilter(displayName))
 	{
+		if(frameHashTestParams)
+		{
+			exitFrameHashTest("File doesn't have a valid extension");
+			return;
+		}
 		postErrorMessage("File doesn't have a valid extension");
 		return;
 	}
@@ -1330,19 +1433,69 @@ void EmuApp::notifyWindowPresented()
 	emuSystemTask.notifyFramePresented();
 }
 
-bool EmuApp::writeScreenshot(IG::PixmapView pix, CStringView path)
+bool EmuApp::writeScreenshot(IG::PixmapView pix, CStringView path, ScreenshotFormat format)
 {
-	return pixmapWriter.writeToFile(pix, path);
+	if(format == ScreenshotFormat::QOI)
+	{
+		auto file = appContext().openFileUri(path, OpenFlags::testNewFile());
+		return file && pixmapWriter.writeQOIToFile(pix, file);
+	}
+	return pixmapWriter.writeToFile(pix, path, {.fastCompression = format == ScreenshotFormat::FastPNG});
 }
 
-FS::PathString EmuApp::makeNextScreenshotFilename()
+FS::PathString EmuApp::makeNextScreenshotFilename(ScreenshotFormat format)
 {
 	static constexpr std::string_view subDirName = "screenshots";
 	auto &sys = system();
 	auto userPath = sys.userPath(userScreenshotPath);
 	sys.createContentLocalDirectory(userPath, subDirName);
+	std::string_view ext = format == ScreenshotFormat::QOI ? ".qoi" : ".png";
+	auto baseName = appContext().formatDateAndTimeAsFilename(WallClock::now());
+	auto path = sys.contentLocalDirectory(userPath, subDirName, std::format("{}{}", baseName, ext));
+	// burst captures can land within the same second, before earlier ones are written
+	for(int i = 2; appContext().fileUriExists(path) || screenshotWriter.isPending(path); i++)
+	{
+		path = sys.contentLocalDirectory(userPath, subDirName, std::format("{} ({}){}", baseName, i, ext));
+	}
+	return path;
+}
+
+FS::PathString EmuApp::makeNextRecordingFilename()
+{
+	static constexpr std::string_view subDirName = "recordings";
+	auto &sys = system();
+	auto userPath = sys.userPath(userScreenshotPath);
+	sys.createContentLocalDirectory(userPath, subDirName);
 	return sys.contentLocalDirectory(userPath, subDirName,
-		appContext().formatDateAndTimeAsFilename(WallClock::now()).append(".png"));
+		appContext().formatDateAndTimeAsFilename(WallClock::now()).append(".avi"));
+}
+
+bool EmuApp::startRecording()
+{
+	auto path = makeNextRecordingFilename();
+	if(!avRecorder.start(appContext().openFileUri(path, OpenFlags::testNewFile()), video.size(), system().frameTime(), audio.format()))
+	{
+		postErrorMessage(4, std::format("Error creating recording at {}", appContext().fileUriDisplayName(path)));
+		return false;
+	}
+	// the emulation thread reads these pointers, only change them while it's idle
+	emuSystemTask.pause();
+	video.avRecorder = &avRecorder;
+	audio.avRecorder = &avRecorder;
+	postMessage(std::format("Recording to {}", appContext().fileUriDisplayName(path)));
+	return true;
+}
+
+void EmuApp::stopRecording()
+{
+	if(!avRecorder.isRecording())
+		return;
+	emuSystemTask.pause();
+	if(!avRecorder.isRecording()) // already stopped by a message flushed during the pause
+		return;
+	video.avRecorder = {};
+	audio.avRecorder = {};
+	avRecorder.stop();
 }
 
 void EmuApp::setMogaManagerActive(bool on, bool notify)
@@ -1587,10 +1740,24 @@ bool EmuApp::setAltSpeed(AltSpeedMode mode, int16_t speed)
 
 void EmuApp::applyCPUAffinity(bool active)
 {
+	if(active)
+	{
+		// helper threads may be started from other threads, give them the emulation task's priority
+		if(auto id = emuSystemTask.threadId())
+			helperThreads().setPriority(threadPriority(id));
+	}
+	else
+	{
+		for(const auto &t : helperThreads().threads())
+		{
+			log.info("helper thread:{} ({}) CPU time:{}", t.name, t.id, duration_cast<Milliseconds>(t.cpuTime));
+		}
+	}
 	if(cpuAffinityMode.value() == CPUAffinityMode::Any)
 		return;
-	auto frameThreadGroup = std::vector{emuSystemTask.threadId(), renderer.task().threadId()};
-	system().addThreadGroupIds(frameThreadGroup);
+	std::array appThreadIds{emuSystemTask.threadId(), renderer.task().threadId()};
+	auto frameThreadGroup = std::vector(appThreadIds.begin(), appThreadIds.end());
+	helperThreads().addFrameThreadIds(frameThreadGroup);
 	for(auto [idx, id] : enumerate(frameThreadGroup))
 	{
 		if(!id)
@@ -1618,7 +1785,8 @@ void EmuApp::applyCPUAffinity(bool active)
 	auto mask = active ?
 		(cpuAffinityMode.value() == CPUAffinityMode::Auto ? appContext().performanceCPUMask() : cpuAffinityMask.value()) : 0;
 	log.info("applying CPU affinity mask {:X}", mask);
-	setThreadCPUAffinityMask(frameThreadGroup, mask);
+	setThreadCPUAffinityMask(appThreadIds, mask);
+	helperThreads().setCPUAffinityMask(mask);
 }
 
 void EmuApp::setCPUAffinity(int cpuNumber, bool on)
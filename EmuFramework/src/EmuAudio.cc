@@ -17,6 +17,8 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuSystem.hh>
 #include <emuframework/Option.hh>
+#include <emuframework/FrameHashRecorder.hh>
+#include <emuframework/AVRecorder.hh>
 #include <imagine/audio/Manager.hh>
 #include <imagine/util/algorithm.h>
 #include <imagine/logger/logger.h>
@@ -149,11 +151,26 @@ void EmuAudio::resizeAudioBuffer(size_t targetBufferFillBytes)
 	}
 }
 
+// Shrinks the fill target when the output reports less latency than the sound buffer setting assumes,
+// keeping one buffer of samples queued on top of what the output holds itself
+void EmuAudio::applyOutputLatency()
+{
+	Nanoseconds latency{outputLatencyNSecs.load(std::memory_order_relaxed)};
+	if(!latency.count())
+		return;
+	auto minFillBytes = bufferIncrementBytes + size_t(format().timeToBytes(latency));
+	if(minFillBytes >= targetBufferFillBytes)
+		return;
+	log.info("output latency:{}, reducing fill target:{} -> {} frames", latency,
+		format().bytesToFrames(targetBufferFillBytes), format().bytesToFrames(minFillBytes));
+	targetBufferFillBytes = minFillBytes;
+}
+
 void EmuAudio::open()
 {
 	close();
 	if(isEnabled())
-		audioStream.setApi(manager, outputAPI());
+		audioStream.setApi(manager, sinkAPI != IG::Audio::Api::DEFAULT ? sinkAPI : outputAPI());
 }
 
 void EmuAudio::start(FloatSeconds bufferDuration)
@@ -219,13 +236,22 @@ void EmuAudio::start(FloatSeconds bufferDuration)
 				}
 			}
 		};
+		outputConf.onLatencyChanged = [this](Nanoseconds latency)
+		{
+			outputLatencyNSecs.store(latency.count(), std::memory_order_relaxed);
+			outputLatencyChanged.store(true, std::memory_order_release);
+		};
 		outputConf.wantedLatencyHint = {};
+		outputConf.filePath = sinkFilePath;
+		outputLatencyNSecs = 0;
+		outputLatencyChanged = false;
 		startAudioStats(inputFormat);
 		audioStream.open(outputConf);
 	}
 	else
 	{
 		startAudioStats(inputFormat);
+		applyOutputLatency();
 		if(shouldStartAudioWrites())
 		{
 			if(Config::DEBUG_BUILD)
@@ -271,8 +297,25 @@ void EmuAudio::writeFrames(const void *samples, size_t framesToWrite)
 {
 	if(!framesToWrite) [[unlikely]]
 		return;
-	assumeExpr(rBuff.capacity());
 	auto inputFormat = format();
+	if(sinkAPI == IG::Audio::Api::WAV_FILE) [[unlikely]]
+	{
+		// record the emulated samples directly so the file doesn't depend on output timing
+		audioStream.writeFile(samples, framesToWrite, inputFormat);
+	}
+	if(avRecorder) [[unlikely]]
+	{
+		avRecorder->addAudio(samples, inputFormat.framesToBytes(framesToWrite));
+	}
+	if(hashRecorder) [[unlikely]]
+	{
+		hashRecorder->addAudio(samples, inputFormat.framesToBytes(framesToWrite));
+		if(!rBuff.capacity())
+			return;
+	}
+	assumeExpr(rBuff.capacity());
+	if(outputLatencyChanged.exchange(false, std::memory_order_acquire)) [[unlikely]]
+		applyOutputLatency();
 	switch(audioWriteState)
 	{
 		case AudioWriteState::MULTI_UNDERRUN:
@@ -404,6 +447,15 @@ void EmuAudio::setOutputAPI(IG::Audio::Api api)
 	open();
 }
 
+void EmuAudio::setSinkOutput(IG::Audio::Api api, CStringView filePath)
+{
+	assert(api == IG::Audio::Api::NULL_SINK || api == IG::Audio::Api::WAV_FILE);
+	log.info("using {} audio sink {}", api == IG::Audio::Api::WAV_FILE ? "WAV file" : "null", filePath);
+	sinkAPI = api;
+	sinkFilePath = filePath;
+	open();
+}
+
 bool EmuAudio::isEnabled() const
 {
 	return flags.enabled;
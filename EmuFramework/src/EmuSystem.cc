@@ -19,6 +19,7 @@
 #include <emuframework/EmuAudio.hh>
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuViewController.hh>
+#include <emuframework/ContentArchiveCache.hh>
 #include <imagine/base/ApplicationContext.hh>
 #include <imagine/fs/ArchiveFS.hh>
 #include <imagine/fs/FSUtils.hh>
@@ -415,36 +416,67 @@ void EmuSystem::loadContentFromPath(CStringView pathStr, std::string_view displa
 		loadContent(nullIO, params, onLoadProgress);
 		return;
 	}
+	auto &app = EmuApp::get(appContext());
+	if(FS::FileString originalName; auto io = app.contentPrefetcher.take(path, originalName))
+	{
+		closeAndSetupNew(path, displayName);
+		if(originalName.size())
+			contentFileName_ = originalName;
+		loadContent(io, params, onLoadProgress);
+		return;
+	}
 	log.info("load from {}:{}", IG::isUri(path) ? "uri" : "path", path);
 	loadContentFromFile(appContext().openFileUri(path, {.accessHint = IOAccessHint::Sequential}),
 		path, displayName, params, onLoadProgress);
 }
 
+ArchiveIO EmuSystem::findArchiveContent(IO file)
+{
+	for(auto &entry : FS::ArchiveIterator{std::move(file)})
+	{
+		if(entry.type() == FS::file_type::directory)
+		{
+			continue;
+		}
+		auto name = entry.name();
+		log.info("archive file entry:{}", name);
+		if(EmuSystem::defaultFsFilter(name))
+		{
+			return std::move(entry);
+		}
+	}
+	throw std::runtime_error("No recognized file extensions in archive");
+}
+
 void EmuSystem::loadContentFromFile(IO file, CStringView path, std::string_view displayName, EmuSystemCreateParams params, OnLoadProgressDelegate onLoadProgress)
 {
 	if(!EmuSystem::handlesArchiveFiles && EmuApp::hasArchiveExtension(displayName))
 	{
-		IO io{};
+		auto &app = EmuApp::get(appContext());
+		auto &cache = app.archiveCache;
+		const bool usesCache = app.cachesArchiveContent;
+		auto cacheKey = usesCache ? cache.archiveKey(path, file.size()) : 0;
 		FS::FileString originalName{};
-		for(auto &entry : FS::ArchiveIterator{std::move(file)})
+		IO io{};
+		if(usesCache)
+			io = cache.open(cacheKey, originalName);
+		if(!io)
 		{
-			if(entry.type() == FS::file_type::directory)
+			auto entry = findArchiveContent(std::move(file));
+			originalName = entry.name();
+			if(!usesCache || !cache.canStore(entry.size()))
+			{
+				io = std::move(entry);
+			}
+			else if(auto cachedIO = cache.add(cacheKey, entry))
 			{
-				continue;
+				io = std::move(cachedIO);
 			}
-			auto name = entry.name();
-			log.info("archive file entry:{}", name);
-			if(EmuSystem::defaultFsFilter(name))
+			else // entry was partially read, re-open the archive
 			{
-				originalName = name;
-				io = std::move(entry);
-				break;
+				io = findArchiveContent(appContext().openFileUri(path, {.accessHint = IOAccessHint::Sequential}));
 			}
 		}
-		if(!io)
-		{
-			throw std::runtime_error("No recognized file extensions in archive");
-		}
 		closeAndSetupNew(path, displayName);
 		contentFileName_ = originalName;
 		loadContent(io, params, onLoadProgress);
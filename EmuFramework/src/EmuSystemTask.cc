@@ -18,6 +18,8 @@
 #include <emuframework/EmuSystemTask.hh>
 #include <imagine/thread/Thread.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
+#include <thread>
 
 namespace EmuEx
 {
@@ -39,6 +41,8 @@ void EmuSystemTask::start()
 		[this](auto &sem)
 		{
 			threadId_ = thisThreadId();
+			frameDelayTuner.reset();
+			missedFrameDeadline = false;
 			auto eventLoop = EventLoop::makeForThread();
 			bool started = true;
 			commandPort.attach(eventLoop, [this, &started](auto msgs)
@@ -80,7 +84,13 @@ void EmuSystemTask::start()
 					if(!framePending)
 					{
 						auto params = std::exchange(frameParams, {});
+						bool useFrameDelay = app.autoFrameDelay && app.frameInterval <= 1;
+						if(useFrameDelay)
+							waitForFrameDelay(params);
+						auto workStart = SteadyClock::now();
 						bool renderingFrame = app.advanceFrames(params, this);
+						if(useFrameDelay && renderingFrame)
+							updateFrameDelay(params, workStart);
 						if(params.isFromRenderer())
 						{
 							framePending = false;
@@ -94,6 +104,7 @@ void EmuSystemTask::start()
 					{
 						log.debug("previous async frame not ready yet");
 						doIfUsed(app.frameTimeStats, [&](auto &stats) { stats.missedFrameCallbacks++; });
+						missedFrameDeadline = true;
 					}
 				}
 				if(syncSemPtr)
@@ -111,6 +122,22 @@ void EmuSystemTask::start()
 		});
 }
 
+void EmuSystemTask::waitForFrameDelay(const FrameParams &params)
+{
+	auto delay = frameDelayTuner.delay(params.frameTime);
+	if(delay.count())
+		std::this_thread::sleep_until(params.timestamp + delay);
+}
+
+void EmuSystemTask::updateFrameDelay(const FrameParams &params, SteadyClockTimePoint workStart)
+{
+	auto workEnd = SteadyClock::now();
+	bool missed = std::exchange(missedFrameDeadline, false) || workEnd > params.timestamp + params.frameTime;
+	frameDelayTuner.addWorkTime(workEnd - workStart, missed);
+	frameDelayUSecs.store(duration_cast<Microseconds>(frameDelayTuner.delay(params.frameTime)).count(), std::memory_order_relaxed);
+	frameWorkUSecs.store(duration_cast<Microseconds>(frameDelayTuner.workTime()).count(), std::memory_order_relaxed);
+}
+
 void EmuSystemTask::pause()
 {
 	if(!taskThread.joinable())
@@ -156,7 +183,40 @@ void EmuSystemTask::sendFrameFinishedReply(EmuVideo &video)
 	video.dispatchFrameFinished();
 }
 
-void EmuSystemTask::sendScreenshotReply(bool success)
+SteadyClockTime FrameDelayTuner::delay(SteadyClockTime frameTime) const
+{
+	if(sampleCount < minSamples)
+		return {};
+	return std::max(frameTime - workTimeP95 - margin, SteadyClockTime{});
+}
+
+void FrameDelayTuner::addWorkTime(SteadyClockTime time, bool missedDeadline)
+{
+	samples[nextSample] = time;
+	nextSample = (nextSample + 1) % maxSamples;
+	sampleCount = std::min(sampleCount + 1, maxSamples);
+	if(missedDeadline)
+	{
+		// back off quickly, then give back the extra margin slowly while frames keep making it
+		margin = std::min(margin * 2, maxMargin);
+		framesSinceMiss = 0;
+		log.debug("missed frame deadline, margin now:{}us", duration_cast<Microseconds>(margin).count());
+	}
+	else if(++framesSinceMiss == framesToReduceMargin)
+	{
+		margin = std::max(margin - Milliseconds{1}, minMargin);
+		framesSinceMiss = 0;
+	}
+	if(sampleCount >= minSamples && (missedDeadline || nextSample % 8 == 0))
+	{
+		auto sorted = samples;
+		auto p95 = sorted.begin() + (sampleCount * 95 / 100);
+		std::nth_element(sorted.begin(), p95, sorted.begin() + sampleCount);
+		workTimeP95 = *p95;
+	}
+}
+
+void EmuSystemTask::sendScreenshotReply(bool success) const
 {
 	app.runOnMainThread([&app = app, success](ApplicationContext ctx)
 	{
@@ -15,6 +15,8 @@
 
 #include <emuframework/EmuVideo.hh>
 #include <emuframework/EmuApp.hh>
+#include <emuframework/FrameHashRecorder.hh>
+#include <emuframework/AVRecorder.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/RendererCommands.hh>
@@ -149,7 +151,15 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, Gfx::LockedTextureBuffe
 {
 	if(screenshotNextFrame) [[unlikely]]
 	{
-		doScreenshot(taskCtx, texBuff.pixmap());
+		doScreenshot(texBuff.pixmap());
+	}
+	if(hashRecorder) [[unlikely]]
+	{
+		hashRecorder->addVideo(texBuff.pixmap());
+	}
+	if(avRecorder) [[unlikely]]
+	{
+		recordVideo(texBuff.pixmap());
 	}
 	app().record(FrameTimeStatEvent::aboutToSubmitFrame);
 	vidImg.unlock(texBuff);
@@ -160,13 +170,42 @@ void EmuVideo::finishFrame(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
 {
 	if(screenshotNextFrame) [[unlikely]]
 	{
-		doScreenshot(taskCtx, pix);
+		doScreenshot(pix);
+	}
+	if(hashRecorder) [[unlikely]]
+	{
+		hashRecorder->addVideo(pix);
+	}
+	if(avRecorder) [[unlikely]]
+	{
+		recordVideo(pix);
 	}
 	app().record(FrameTimeStatEvent::aboutToSubmitFrame);
 	vidImg.write(pix, {.async = true});
 	postFrameFinished(taskCtx);
 }
 
+static const char *recordingStopMessage(AVRecorder::StopReason reason)
+{
+	switch(reason)
+	{
+		case AVRecorder::StopReason::fileFull: return "Recording stopped since it reached the maximum file size";
+		case AVRecorder::StopReason::writeError: return "Recording stopped due to an error writing the file";
+		default: return "Recording stopped since the video size changed";
+	}
+}
+
+void EmuVideo::recordVideo(IG::PixmapView pix)
+{
+	if(avRecorder->addVideo(pix))
+		return;
+	app().runOnMainThread([&app = app(), reason = avRecorder->stopReason()](ApplicationContext)
+	{
+		app.stopRecording();
+		app.postErrorMessage(4, recordingStopMessage(reason));
+	});
+}
+
 void EmuVideo::clear()
 {
 	if(!vidImg)
@@ -179,17 +218,15 @@ void EmuVideo::takeGameScreenshot()
 	screenshotNextFrame = true;
 }
 
-void EmuVideo::doScreenshot(EmuSystemTaskContext taskCtx, IG::PixmapView pix)
+void EmuVideo::doScreenshot(IG::PixmapView pix)
 {
 	screenshotNextFrame = false;
-	auto success = app().writeScreenshot(pix, app().makeNextScreenshotFilename());
-	if(taskCtx)
-	{
-		taskCtx.task().sendScreenshotReply(success);
-	}
-	else
+	// name the file now so it matches the capture time, encoding happens on the writer thread,
+	// which sends the reply when done
+	auto format = app().screenshotFormat.value();
+	if(!app().screenshotWriter.write(pix, app().makeNextScreenshotFilename(format), format))
 	{
-		app().printScreenshotResult(success);
+		app().systemTask().sendScreenshotReply(false);
 	}
 }
 
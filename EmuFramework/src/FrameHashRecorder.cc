@@ -0,0 +1,179 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+
+#include <emuframework/FrameHashRecorder.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/util/format.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+#include <charconv>
+#include <string>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"FrameHash"};
+
+// 64-bit FNV-1a
+constexpr uint64_t hashSeed = 0xcbf29ce484222325;
+
+static uint64_t hashBytes(uint64_t hash, const uint8_t *data, size_t size)
+{
+	for(auto b : std::span{data, size})
+	{
+		hash ^= b;
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+void FrameHashRecorder::addVideo(PixmapView pix)
+{
+	// hash row by row so buffer padding doesn't affect the result
+	auto rowBytes = pix.w() * pix.format().bytesPerPixel();
+	auto hash = hashSeed;
+	for(auto y : iotaCount(pix.h()))
+	{
+		hash = hashBytes(hash, reinterpret_cast<const uint8_t*>(pix.data({0, y})), rowBytes);
+	}
+	current.video = hash;
+	hasVideo = true;
+}
+
+void FrameHashRecorder::addAudio(const void *samples, size_t bytes)
+{
+	current.audio = hashBytes(current.audio ? current.audio : hashSeed, static_cast<const uint8_t*>(samples), bytes);
+}
+
+void FrameHashRecorder::endFrame()
+{
+	// frames without new video repeat the previous image
+	if(hasVideo)
+		lastVideoHash = current.video;
+	else
+		current.video = lastVideoHash;
+	hashes.emplace_back(current);
+	current = {};
+	hasVideo = false;
+}
+
+bool FrameHashRecorder::writeFile(ApplicationContext ctx, CStringView path) const
+{
+	auto file = ctx.openFileUri(path, OpenFlags::testNewFile());
+	if(!file)
+	{
+		log.error("error creating hash file:{}", path);
+		return false;
+	}
+	std::string str;
+	for(auto frame : iotaCount(hashes.size()))
+	{
+		std::format_to(std::back_inserter(str), "{} {:016x} {:016x}\n", frame, hashes[frame].video, hashes[frame].audio);
+	}
+	file.write(str.data(), str.size());
+	log.info("wrote {} frame hashes to:{}", hashes.size(), path);
+	return true;
+}
+
+static std::string readTextFile(ApplicationContext ctx, CStringView path)
+{
+	std::string str;
+	auto file = ctx.openFileUri(path, {.test = true});
+	if(!file)
+	{
+		log.error("error opening file:{}", path);
+		return str;
+	}
+	file.readSized(str, file.size());
+	return str;
+}
+
+// calls the function for each line that isn't empty or a comment with its space-separated fields
+static void forEachLineFields(std::string_view str, auto &&func)
+{
+	for(auto lineRange : std::views::split(str, '\n'))
+	{
+		std::string_view line{lineRange.begin(), lineRange.end()};
+		if(line.empty() || line.front() == '#')
+			continue;
+		std::vector<std::string_view> fields;
+		for(auto fieldRange : std::views::split(line, ' '))
+		{
+			if(!fieldRange.empty())
+				fields.emplace_back(fieldRange.begin(), fieldRange.end());
+		}
+		func(fields);
+	}
+}
+
+template<class T>
+static T parseField(std::string_view field, int base = 10)
+{
+	T val{};
+	std::from_chars(field.data(), field.data() + field.size(), val, base);
+	return val;
+}
+
+int FrameHashRecorder::firstMismatchedFrame(ApplicationContext ctx, CStringView goldenPath) const
+{
+	std::vector<FrameHash> goldenHashes;
+	forEachLineFields(readTextFile(ctx, goldenPath), [&](std::span<const std::string_view> fields)
+	{
+		if(fields.size() < 3)
+			return;
+		goldenHashes.emplace_back(parseField<uint64_t>(fields[1], 16), parseField<uint64_t>(fields[2], 16));
+	});
+	for(auto frame : iotaCount(int(hashes.size())))
+	{
+		if(size_t(frame) >= goldenHashes.size())
+		{
+			log.error("golden file only has {} frames", goldenHashes.size());
+			return frame;
+		}
+		const auto &h = hashes[frame];
+		if(h != goldenHashes[frame])
+		{
+			log.error("frame:{} video:{:016x} audio:{:016x} doesn't match golden video:{:016x} audio:{:016x}",
+				frame, h.video, h.audio, goldenHashes[frame].video, goldenHashes[frame].audio);
+			return frame;
+		}
+	}
+	if(goldenHashes.size() > hashes.size())
+	{
+		log.error("golden file has {} frames but only {} were run", goldenHashes.size(), hashes.size());
+		return hashes.size();
+	}
+	return -1;
+}
+
+std::vector<ScriptedInput> FrameHashRecorder::readScriptedInput(ApplicationContext ctx, CStringView path)
+{
+	// each line has the format: <frame> <key code> <1 = pushed, 0 = released>
+	std::vector<ScriptedInput> inputs;
+	forEachLineFields(readTextFile(ctx, path), [&](std::span<const std::string_view> fields)
+	{
+		if(fields.size() < 3)
+			return;
+		inputs.emplace_back(parseField<int>(fields[0]), parseField<KeyCode>(fields[1]), parseField<int>(fields[2]) != 0);
+	});
+	std::ranges::stable_sort(inputs, {}, &ScriptedInput::frame);
+	log.info("read {} input events from:{}", inputs.size(), path);
+	return inputs;
+}
+
+}
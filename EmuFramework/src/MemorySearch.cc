@@ -0,0 +1,218 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/MemorySearch.hh>
+#include <imagine/util/math.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <bit>
+#include <cassert>
+#include <cstring>
+
+namespace EmuEx
+{
+
+// word swapped regions read as big-endian 16-bit values only on little-endian hosts
+static_assert(std::endian::native == std::endian::little);
+
+constexpr SystemLogger log{"MemorySearch"};
+constexpr size_t vecBytes = 16;
+
+// generic vector types map to SSE2/NEON registers on the targets we build for
+typedef uint8_t U8Vec __attribute__((vector_size(vecBytes)));
+typedef uint16_t U16Vec __attribute__((vector_size(vecBytes)));
+typedef uint32_t U32Vec __attribute__((vector_size(vecBytes)));
+
+template <class T> struct VecFor;
+template <> struct VecFor<uint8_t> { using type = U8Vec; };
+template <> struct VecFor<uint16_t> { using type = U16Vec; };
+template <> struct VecFor<uint32_t> { using type = U32Vec; };
+
+template <SearchComparison cmp, class V>
+static V compare(V a, V b)
+{
+	if constexpr(cmp == SearchComparison::Equal)
+		return (V)(a == b);
+	else if constexpr(cmp == SearchComparison::NotEqual)
+		return (V)(a != b);
+	else if constexpr(cmp == SearchComparison::Less)
+		return (V)(a < b);
+	else if constexpr(cmp == SearchComparison::Greater)
+		return (V)(a > b);
+	else if constexpr(cmp == SearchComparison::LessOrEqual)
+		return (V)(a <= b);
+	else
+		return (V)(a >= b);
+}
+
+template <class T, SearchComparison cmp>
+static void filterRegion(const uint8_t *mem, size_t size, uint8_t *snapshot, uint8_t *mask, std::optional<uint32_t> value, bool swapHalves)
+{
+	using V = typename VecFor<T>::type;
+	const V constant = V{} + T(value.value_or(0));
+	auto filterBlock = [&](size_t i, V cur)
+	{
+		if constexpr(sizeof(T) == 4)
+		{
+			if(swapHalves)
+				cur = (cur << 16) | (cur >> 16);
+		}
+		V m, ref = constant;
+		std::memcpy(&m, mask + i, vecBytes);
+		if(!value)
+			std::memcpy(&ref, snapshot + i, vecBytes);
+		m &= compare<cmp>(cur, ref);
+		std::memcpy(mask + i, &m, vecBytes);
+		std::memcpy(snapshot + i, &cur, vecBytes);
+	};
+	const size_t blocksSize = size & ~(vecBytes - 1);
+	for(size_t i = 0; i < blocksSize; i += vecBytes)
+	{
+		V cur;
+		std::memcpy(&cur, mem + i, vecBytes);
+		filterBlock(i, cur);
+	}
+	if(blocksSize != size)
+	{
+		// the padding lanes of the last block are never candidates
+		V cur{};
+		std::memcpy(&cur, mem + blocksSize, size - blocksSize);
+		filterBlock(blocksSize, cur);
+	}
+}
+
+template <class T>
+static void filterRegion(SearchComparison cmp, const uint8_t *mem, size_t size, uint8_t *snapshot, uint8_t *mask, std::optional<uint32_t> value, bool swapHalves = false)
+{
+	switch(cmp)
+	{
+		case SearchComparison::Equal: return filterRegion<T, SearchComparison::Equal>(mem, size, snapshot, mask, value, swapHalves);
+		case SearchComparison::NotEqual: return filterRegion<T, SearchComparison::NotEqual>(mem, size, snapshot, mask, value, swapHalves);
+		case SearchComparison::Less: return filterRegion<T, SearchComparison::Less>(mem, size, snapshot, mask, value, swapHalves);
+		case SearchComparison::Greater: return filterRegion<T, SearchComparison::Greater>(mem, size, snapshot, mask, value, swapHalves);
+		case SearchComparison::LessOrEqual: return filterRegion<T, SearchComparison::LessOrEqual>(mem, size, snapshot, mask, value, swapHalves);
+		case SearchComparison::GreaterOrEqual: return filterRegion<T, SearchComparison::GreaterOrEqual>(mem, size, snapshot, mask, value, swapHalves);
+	}
+}
+
+static uint32_t readValue(const uint8_t *p, uint8_t bytes)
+{
+	switch(bytes)
+	{
+		case 1: return *p;
+		case 2: { uint16_t v; std::memcpy(&v, p, 2); return v; }
+		default: { uint32_t v; std::memcpy(&v, p, 4); return v; }
+	}
+}
+
+void MemorySearch::start(std::span<const MemoryRegion> memRegions, uint8_t valueBytes)
+{
+	assert(valueBytes == 1 || valueBytes == 2 || valueBytes == 4);
+	clear();
+	valueBytes_ = valueBytes;
+	for(const auto &r : memRegions)
+	{
+		auto paddedSize = alignRoundedUp(r.data.size(), vecBytes);
+		auto &state = regions.emplace_back(r.address, r.data.size(),
+			std::vector<uint8_t>(paddedSize), std::vector<uint8_t>(paddedSize), r.wordSwapped);
+		std::ranges::copy(r.data, state.snapshot.begin());
+		if(r.wordSwapped && valueBytes == 4)
+		{
+			for(size_t i = 0; i < paddedSize; i += 4)
+			{
+				uint32_t v;
+				std::memcpy(&v, &state.snapshot[i], 4);
+				v = std::rotl(v, 16);
+				std::memcpy(&state.snapshot[i], &v, 4);
+			}
+		}
+		// values must be aligned and fit inside the region
+		auto valueLanes = r.data.size() / valueBytes;
+		std::fill_n(state.candidateMask.begin(), valueLanes * valueBytes, 0xFF);
+		candidates += valueLanes;
+	}
+	log.info("started {}-bit search with {} candidates in {} regions", valueBytes * 8, candidates, regions.size());
+}
+
+bool MemorySearch::filterByValue(std::span<const MemoryRegion> memRegions, SearchComparison cmp, uint64_t value)
+{
+	if(!valueFits(value))
+	{
+		log.error("value:{} doesn't fit in {} bytes", value, valueBytes_);
+		return false;
+	}
+	return filter(memRegions, cmp, uint32_t(value));
+}
+
+bool MemorySearch::filter(std::span<const MemoryRegion> memRegions, SearchComparison cmp, std::optional<uint32_t> value)
+{
+	if(memRegions.size() != regions.size())
+	{
+		log.error("memory regions changed since search started");
+		return false;
+	}
+	candidates = 0;
+	for(auto i : iotaCount(regions.size()))
+	{
+		auto &r = memRegions[i];
+		auto &state = regions[i];
+		if(r.data.size() != state.size)
+		{
+			log.error("size of region:{} changed since search started", r.name);
+			clear();
+			return false;
+		}
+		auto mem = r.data.data();
+		switch(valueBytes_)
+		{
+			case 1: filterRegion<uint8_t>(cmp, mem, state.size, state.snapshot.data(), state.candidateMask.data(), value); break;
+			case 2: filterRegion<uint16_t>(cmp, mem, state.size, state.snapshot.data(), state.candidateMask.data(), value); break;
+			default: filterRegion<uint32_t>(cmp, mem, state.size, state.snapshot.data(), state.candidateMask.data(), value, state.wordSwapped); break;
+		}
+		// only the first byte of each value's mask needs checking
+		for(size_t offset = 0; offset < state.size; offset += valueBytes_)
+		{
+			candidates += state.candidateMask[offset] != 0;
+		}
+	}
+	return true;
+}
+
+std::vector<MemorySearch::Result> MemorySearch::results(size_t maxResults) const
+{
+	std::vector<Result> res;
+	for(const auto &state : regions)
+	{
+		// only single bytes are stored at a different offset than their address
+		const size_t addressXor = state.wordSwapped && valueBytes_ == 1;
+		for(size_t offset = 0; offset < state.size; offset += valueBytes_)
+		{
+			if(res.size() == maxResults)
+				return res;
+			auto i = offset ^ addressXor;
+			if(state.candidateMask[i])
+				res.emplace_back(uint32_t(state.address + offset), readValue(&state.snapshot[i], valueBytes_));
+		}
+	}
+	return res;
+}
+
+void MemorySearch::clear()
+{
+	regions.clear();
+	candidates = 0;
+}
+
+}
@@ -17,13 +17,17 @@
 #include <emuframework/EmuApp.hh>
 #include <emuframework/Option.hh>
 #include <emuframework/EmuOptions.hh>
+#include <imagine/util/math.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
 
 namespace EmuEx
 {
 
 constexpr SystemLogger log{"RewindMgr"};
 constexpr Seconds defaultSaveFreq{1};
+// leading payload size, then trailing state size, dense flag, and payload size
+constexpr size_t deltaOverheadWords = 4;
 
 RewindManager::RewindManager(EmuApp &app):
 	saveTimer
@@ -42,8 +46,11 @@ RewindManager::RewindManager(EmuApp &app):
 void RewindManager::clear()
 {
 	saveTimer.cancel();
-	stateEntries = {};
-	stateIdx = 0;
+	deltas = {};
+	currState = {};
+	newState = {};
+	deltasUsed = 0;
+	currStateSize = 0;
 	stateSize = 0;
 }
 
@@ -51,16 +58,36 @@ bool RewindManager::reset()
 {
 	if(!stateSize)
 		return true;
+	deltas = {};
+	currState = {};
+	newState = {};
+	deltasUsed = 0;
+	currStateSize = 0;
+	if(!maxStates)
+		return true;
 	try
 	{
-		if(maxStates)
-			log.info("allocating {} states of size:{}", maxStates, stateSize);
-		stateEntries.reset(maxStates, stateSize);
-		stateIdx = 0;
+		// stay within the memory of maxStates full states, currState and newState use two of them
+		// and the delta ring gets the rest, enough for that many dense deltas
+		auto stateBytes = stateWords() * sizeof(uint32_t);
+		currState = std::make_unique<uint32_t[]>(stateWords());
+		if(maxStates <= 2)
+		{
+			log.info("allocating {} bytes for a single state of size:{}", stateBytes, stateSize);
+			return true;
+		}
+		deltasCapacity = (maxStates - 2) * (stateWords() + deltaOverheadWords);
+		log.info("allocating {} bytes for states of size:{}", deltasCapacity * sizeof(uint32_t) + stateBytes * 2, stateSize);
+		deltas = std::make_unique<uint32_t[]>(deltasCapacity);
+		deltasTop = 0;
+		newState = std::make_unique<uint32_t[]>(stateWords());
 		return true;
 	}
 	catch(...)
 	{
+		deltas = {};
+		currState = {};
+		newState = {};
 		return false;
 	}
 }
@@ -68,31 +95,116 @@ bool RewindManager::reset()
 void RewindManager::saveState(EmuApp &app)
 {
 	assumeExpr(maxStates);
-	assumeExpr(stateIdx < maxStates);
-	//log.debug("saving rewind state index:{}", stateIdx);
-	auto &entry = stateEntries[stateIdx];
-	stateIdx = stateIdx + 1 == maxStates ? 0 : stateIdx + 1;
-	entry.size = app.writeState({entry.data, stateSize}, {.uncompressed = true});
+	if(!deltas)
+	{
+		// budget only fits the latest state
+		currStateSize = app.writeState({reinterpret_cast<uint8_t*>(currState.get()), stateSize}, {.uncompressed = true});
+		return;
+	}
+	auto newStateBytes = std::span{reinterpret_cast<uint8_t*>(newState.get()), stateWords() * 4};
+	auto size = app.writeState(newStateBytes.first(stateSize), {.uncompressed = true});
+	if(!size)
+		return;
+	std::ranges::fill(newStateBytes.subspan(size), 0);
+	if(currStateSize)
+		pushDelta();
+	std::swap(currState, newState);
+	currStateSize = size;
+}
+
+void RewindManager::pushDelta()
+{
+	size_t changedWords{};
+	for(size_t i = 0; i < stateWords(); i++)
+	{
+		changedWords += currState[i] != newState[i];
+	}
+	// sparse deltas take 2 words per change, once half the state changes XOR-ing every word is no larger
+	const bool isDense = changedWords * 2 >= stateWords();
+	const size_t payloadWords = isDense ? stateWords() : changedWords * 2;
+	const size_t deltaWords = payloadWords + deltaOverheadWords;
+	while(deltasUsed + deltaWords > deltasCapacity)
+		dropOldestDelta();
+	auto put = [&](uint32_t word)
+	{
+		deltas[deltasTop] = word;
+		deltasTop = deltasTop + 1 == deltasCapacity ? 0 : deltasTop + 1;
+	};
+	put(payloadWords);
+	for(size_t i = 0; i < stateWords(); i++)
+	{
+		auto xorVal = currState[i] ^ newState[i];
+		if(isDense)
+		{
+			put(xorVal);
+		}
+		else if(xorVal)
+		{
+			put(i);
+			put(xorVal);
+		}
+	}
+	put(currStateSize); // size of the state this delta restores
+	put(isDense);
+	put(payloadWords);
+	deltasUsed += deltaWords;
+}
+
+// Applies the most recent delta to currState, returns false if none are left
+bool RewindManager::popDelta()
+{
+	if(!deltasUsed)
+		return false;
+	auto get = [&]
+	{
+		deltasTop = (deltasTop ? deltasTop : deltasCapacity) - 1;
+		return deltas[deltasTop];
+	};
+	const size_t payloadWords = get();
+	const bool isDense = get();
+	currStateSize = get();
+	if(isDense)
+	{
+		for(auto i = stateWords(); i--;)
+		{
+			currState[i] ^= get();
+		}
+	}
+	else
+	{
+		for(auto n = payloadWords / 2; n--;)
+		{
+			auto xorVal = get();
+			currState[get()] ^= xorVal;
+		}
+	}
+	get(); // leading payload size
+	deltasUsed -= payloadWords + deltaOverheadWords;
+	return true;
+}
+
+void RewindManager::dropOldestDelta()
+{
+	auto bottom = deltasTop + deltasCapacity - deltasUsed;
+	if(bottom >= deltasCapacity)
+		bottom -= deltasCapacity;
+	deltasUsed -= deltas[bottom] + deltaOverheadWords;
 }
 
 void RewindManager::rewindState(EmuApp &app)
 {
-	if(!maxStates)
-		return;
-	assumeExpr(stateIdx < maxStates);
-	auto prevIdx = stateIdx ? stateIdx - 1 : maxStates - 1;
-	auto &entry = stateEntries[prevIdx];
-	if(!entry.size)
+	if(!maxStates || !currStateSize)
 		return;
-	log.info("rewinding to state index:{}", prevIdx);
-	app.readState({entry.data, std::exchange(entry.size, 0)});
-	stateIdx = prevIdx;
+	log.info("rewinding to state of size:{}", currStateSize);
+	app.readState({reinterpret_cast<uint8_t*>(currState.get()), currStateSize});
+	if(!popDelta())
+		currStateSize = 0;
 	saveTimer.reset();
 }
 
 void RewindManager::startTimer()
 {
-	if(!stateEntries.size())
+	if(!currState)
 		return;
 	saveTimer.start();
 }
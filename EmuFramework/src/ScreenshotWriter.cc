@@ -0,0 +1,99 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <emuframework/ScreenshotWriter.hh>
+#include <emuframework/EmuApp.hh>
+#include <imagine/thread/ThreadRegistry.hh>
+#include <imagine/logger/logger.h>
+#include <algorithm>
+
+namespace EmuEx
+{
+
+constexpr SystemLogger log{"ScreenshotWriter"};
+// enough for a short burst of captures while earlier ones are still encoding
+constexpr size_t maxPendingJobs = 4;
+
+ScreenshotWriter::~ScreenshotWriter()
+{
+	if(!thread.joinable())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quitting = true;
+	}
+	jobCond.notify_one();
+	thread.join();
+}
+
+bool ScreenshotWriter::write(PixmapView pix, FS::PathString path, ScreenshotFormat format)
+{
+	Job job{.path = std::move(path), .format = format};
+	{
+		std::scoped_lock lock{mutex};
+		if(jobs.size() == maxPendingJobs)
+		{
+			log.warn("{} screenshots still pending, skipping capture", maxPendingJobs);
+			return false;
+		}
+		if(pool.size())
+		{
+			job.pixmap = std::move(pool.back());
+			pool.pop_back();
+		}
+	}
+	if(job.pixmap.desc() != pix.desc())
+		job.pixmap = MemPixmap{pix.desc()};
+	job.pixmap.view().write(pix);
+	{
+		std::scoped_lock lock{mutex};
+		jobs.emplace_back(std::move(job));
+		if(!thread.joinable())
+			thread = std::thread{[this]{ run(); }};
+	}
+	jobCond.notify_one();
+	return true;
+}
+
+bool ScreenshotWriter::isPending(CStringView path)
+{
+	std::scoped_lock lock{mutex};
+	return std::ranges::any_of(jobs, [&](const Job &job){ return std::string_view{job.path} == std::string_view{path}; });
+}
+
+void ScreenshotWriter::run()
+{
+	auto registration = helperThreads().registerThisThread("Screenshot Writer", ThreadRole::background);
+	for(;;)
+	{
+		Job *jobPtr;
+		{
+			std::unique_lock lock{mutex};
+			jobCond.wait(lock, [&]{ return jobs.size() || quitting; });
+			if(jobs.empty())
+				return;
+			// only the writer thread removes jobs and appending doesn't move existing elements
+			jobPtr = &jobs.front();
+		}
+		auto &job = *jobPtr;
+		auto success = app.writeScreenshot(job.pixmap.view(), job.path, job.format);
+		app.systemTask().sendScreenshotReply(success);
+		std::scoped_lock lock{mutex};
+		pool.emplace_back(std::move(job.pixmap));
+		jobs.pop_front();
+	}
+}
+
+}
@@ -15,6 +15,7 @@
 
 #include <emuframework/Cheats.hh>
 #include <emuframework/EmuApp.hh>
+#include "RAMSearchView.hh"
 #include <imagine/gui/TextEntry.hh>
 
 namespace EmuEx
@@ -29,13 +30,15 @@ BaseCheatsView::BaseCheatsView(ViewAttachParams attach):
 		{
 			return msg.visit(overloaded
 			{
-				[&](const ItemsMessage &m) -> ItemReply { return 1 + cheat.size(); },
+				[&](const ItemsMessage &m) -> ItemReply { return 1 + hasRAMSearch + cheat.size(); },
 				[&](const GetItemMessage &m) -> ItemReply
 				{
 					if(m.idx == 0)
 						return &edit;
+					else if(hasRAMSearch && m.idx == 1)
+						return &ramSearch;
 					else
-						return &cheat[m.idx - 1];
+						return &cheat[m.idx - 1 - hasRAMSearch];
 				},
 			});
 		}
@@ -56,7 +59,13 @@ BaseCheatsView::BaseCheatsView(ViewAttachParams attach):
 				});
 			pushAndShow(std::move(editCheatsView), e);
 		}
-	} {}
+	},
+	ramSearch
+	{
+		"RAM Search", attach,
+		[this](const Input::Event &e) { pushAndShow(makeView<RAMSearchView>(), e); }
+	},
+	hasRAMSearch{system().memoryRegions().size() > 0} {}
 
 BaseEditCheatListView::BaseEditCheatListView(ViewAttachParams attach, TableView::ItemSourceDelegate itemSrc):
 	TableView
@@ -155,6 +155,31 @@ FilePathOptionView::FilePathOptionView(ViewAttachParams attach, bool customMenu)
 					screenshotPath.compile(screenshotsMenuName(appContext(), path));
 				}), e);
 		}
+	},
+	screenshotFormatItems
+	{
+		{"PNG",                              attach, MenuItem::Config{.id = ScreenshotFormat::PNG}},
+		{"QOI (Fastest, for burst capture)", attach, MenuItem::Config{.id = ScreenshotFormat::QOI}},
+		{"Fast PNG (Larger files)",          attach, MenuItem::Config{.id = ScreenshotFormat::FastPNG}},
+	},
+	screenshotFormat
+	{
+		"Screenshot Format", attach,
+		MenuId{ScreenshotFormat(app().screenshotFormat)},
+		// Fast PNG is last so it can be left out where it's unsupported
+		std::span{screenshotFormatItems}.first(Config::envIsAndroid ? 2 : 3),
+		MultiChoiceMenuItem::Config
+		{
+			.onSetDisplayString = [this](auto idx, Gfx::Text &t)
+			{
+				t.resetString(wise_enum::to_string(ScreenshotFormat(app().screenshotFormat)));
+				return true;
+			},
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				app().screenshotFormat = ScreenshotFormat(item.id.val);
+			}
+		},
 	}
 {
 	if(!customMenu)
@@ -167,6 +192,7 @@ void FilePathOptionView::loadStockItems()
 {
 	item.emplace_back(&savePath);
 	item.emplace_back(&screenshotPath);
+	item.emplace_back(&screenshotFormat);
 }
 
 void FilePathOptionView::onSavePathChange(std::string_view path)
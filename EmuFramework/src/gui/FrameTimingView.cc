@@ -406,6 +406,27 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 		app().allowBlankFrameInsertion,
 		[this](BoolMenuItem &item) { app().allowBlankFrameInsertion = item.flipBoolValue(*this); }
 	},
+	autoFrameDelay
+	{
+		"Auto Frame Delay", attach,
+		app().autoFrameDelay,
+		[this](BoolMenuItem &item)
+		{
+			app().autoFrameDelay = item.flipBoolValue(*this);
+			frameDelayStatus.set2ndName(frameDelayStatusString());
+			frameDelayStatus.place();
+		}
+	},
+	frameDelayStatus
+	{
+		"Current Frame Delay", frameDelayStatusString(), attach,
+		[this](DualTextMenuItem &item)
+		{
+			item.set2ndName(frameDelayStatusString());
+			item.place();
+			postDraw();
+		}
+	},
 	advancedHeading{"Advanced", attach}
 {
 	loadStockItems();
@@ -414,6 +435,8 @@ FrameTimingView::FrameTimingView(ViewAttachParams attach):
 void FrameTimingView::loadStockItems()
 {
 	item.emplace_back(&frameInterval);
+	item.emplace_back(&autoFrameDelay);
+	item.emplace_back(&frameDelayStatus);
 	item.emplace_back(&frameRate);
 	if(EmuSystem::hasPALVideoSystem)
 	{
@@ -432,6 +455,16 @@ void FrameTimingView::loadStockItems()
 		item.emplace_back(&screenFrameRate);
 }
 
+std::string FrameTimingView::frameDelayStatusString() const
+{
+	if(!app().autoFrameDelay)
+		return "Off";
+	auto &task = app().systemTask();
+	if(!task.frameWorkTime().count())
+		return "Not measured yet";
+	return std::format("{:.1f}ms (work {:.1f}ms)", task.frameDelay().count() / 1000., task.frameWorkTime().count() / 1000.);
+}
+
 bool FrameTimingView::onFrameTimeChange(VideoSystem vidSys, SteadyClockTime time)
 {
 	if(!app().outputTimingManager.setFrameTimeOption(vidSys, time))
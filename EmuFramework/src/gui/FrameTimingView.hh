@@ -53,10 +53,13 @@ protected:
 	ConditionalMember<Gfx::supportsPresentationTime, TextMenuItem> presentationTimeItems[3];
 	ConditionalMember<Gfx::supportsPresentationTime, MultiChoiceMenuItem> presentationTime;
 	BoolMenuItem blankFrameInsertion;
+	BoolMenuItem autoFrameDelay;
+	DualTextMenuItem frameDelayStatus;
 	TextHeadingMenuItem advancedHeading;
-	StaticArrayList<MenuItem*, 10> item;
+	StaticArrayList<MenuItem*, 12> item;
 
 	bool onFrameTimeChange(VideoSystem vidSys, SteadyClockTime time);
+	std::string frameDelayStatusString() const;
 };
 
 }
@@ -221,6 +221,37 @@ GUIOptionView::GUIOptionView(ViewAttachParams attach, bool customMenu):
 				});
 		}
 	},
+	prefetchContent
+	{
+		"Preload Recent Content", attach,
+		app().prefetchesContent,
+		[this](BoolMenuItem &item)
+		{
+			app().prefetchesContent = item.flipBoolValue(*this);
+			if(!app().prefetchesContent)
+				app().contentPrefetcher.clear();
+		}
+	},
+	cacheArchiveContent
+	{
+		"Cache Extracted Archive Content", attach,
+		app().cachesArchiveContent,
+		[this](BoolMenuItem &item)
+		{
+			app().cachesArchiveContent = item.flipBoolValue(*this);
+			if(!app().cachesArchiveContent)
+				app().archiveCache.clear();
+		}
+	},
+	clearArchiveCache
+	{
+		"Clear Archive Content Cache", attach,
+		[this]
+		{
+			auto freedSize = app().archiveCache.clear();
+			app().postMessage(std::format("Freed {:.1f} MB", freedSize / (1024. * 1024.)));
+		}
+	},
 	orientationHeading
 	{
 		"Orientation", attach
@@ -347,6 +378,13 @@ void GUIOptionView::loadStockItems()
 		item.emplace_back(&showBluetoothScan);
 	item.emplace_back(&showHiddenFiles);
 	item.emplace_back(&maxRecentContent);
+	if(EmuSystem::handlesGenericIO)
+		item.emplace_back(&prefetchContent);
+	if(EmuSystem::handlesGenericIO && !EmuSystem::handlesArchiveFiles)
+	{
+		item.emplace_back(&cacheArchiveContent);
+		item.emplace_back(&clearArchiveCache);
+	}
 	item.emplace_back(&orientationHeading);
 	item.emplace_back(&emuOrientation);
 	item.emplace_back(&menuOrientation);
@@ -45,6 +45,11 @@ LoadProgressView::LoadProgressView(ViewAttachParams attach, const Input::Event &
 						msgs.readExtraData(std::span{errorStr, len});
 						msgPort.detach();
 						auto &app = this->app();
+						if(app.frameHashTestParams)
+						{
+							app.exitFrameHashTest(std::string_view{errorStr, len});
+							return;
+						}
 						app.popModalViews();
 						app.postErrorMessage(4, std::string_view{errorStr, len});
 						return;
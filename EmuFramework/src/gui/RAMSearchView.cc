@@ -0,0 +1,142 @@
+/*  This file is part of EmuFramework.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with EmuFramework.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "RAMSearchView.hh"
+#include <emuframework/EmuApp.hh>
+#include <emuframework/viewUtils.hh>
+#include <imagine/util/format.hh>
+#include <cstdlib>
+
+namespace EmuEx
+{
+
+// only the first results are listed, the search should be narrowed further before then
+constexpr size_t maxListedResults = 64;
+
+RAMSearchView::RAMSearchView(ViewAttachParams attach):
+	TableView{"RAM Search", attach, menuItems},
+	valueSizeItems
+	{
+		{"8-bit",  attach, {.id = 1}},
+		{"16-bit", attach, {.id = 2}},
+		{"32-bit", attach, {.id = 4}},
+	},
+	valueSize
+	{
+		"Value Size", attach,
+		MenuId{app().memorySearch.isActive() ? app().memorySearch.valueBytes() : uint8_t(1)},
+		valueSizeItems,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item) { newSearchValueBytes = item.id.val; }
+		}
+	},
+	newSearch
+	{
+		"Start New Search", attach,
+		[this]
+		{
+			app().memorySearch.start(system().memoryRegions(), newSearchValueBytes);
+			refreshResults();
+		}
+	},
+	filtersHeading{"Filter Candidates", attach},
+	equalToValue
+	{
+		"Equal To Value", attach,
+		[this](const Input::Event &e)
+		{
+			pushAndShowNewCollectValueInputView<const char*>(attachParams(), e,
+				"Input decimal or 0x-prefixed hex value", "",
+				[this](CollectTextInputView &, auto str)
+				{
+					char *end;
+					auto value = std::strtoull(str, &end, 0);
+					if(*end)
+					{
+						app().postErrorMessage("Invalid value");
+						return false;
+					}
+					if(!app().memorySearch.valueFits(value))
+					{
+						app().postErrorMessage(std::format("Value doesn't fit in {} bits", app().memorySearch.valueBytes() * 8));
+						return false;
+					}
+					if(!app().memorySearch.filterByValue(system().memoryRegions(), SearchComparison::Equal, value))
+						app().postErrorMessage("Memory layout changed, start a new search");
+					refreshResults();
+					return true;
+				});
+		}
+	},
+	increased{"Increased Since Last Filter", attach, [this]{ filterByLastValue(SearchComparison::Greater); }},
+	decreased{"Decreased Since Last Filter", attach, [this]{ filterByLastValue(SearchComparison::Less); }},
+	changed{"Changed Since Last Filter", attach, [this]{ filterByLastValue(SearchComparison::NotEqual); }},
+	unchanged{"Unchanged Since Last Filter", attach, [this]{ filterByLastValue(SearchComparison::Equal); }},
+	resultsHeading{"Results", attach}
+{
+	if(app().memorySearch.isActive())
+		newSearchValueBytes = app().memorySearch.valueBytes();
+	loadItems();
+}
+
+void RAMSearchView::filterByLastValue(SearchComparison cmp)
+{
+	if(!app().memorySearch.filterByLastValue(system().memoryRegions(), cmp))
+		app().postErrorMessage("Memory layout changed, start a new search");
+	refreshResults();
+}
+
+void RAMSearchView::refreshResults()
+{
+	loadItems();
+	place();
+}
+
+void RAMSearchView::loadItems()
+{
+	auto &search = app().memorySearch;
+	for(auto item : std::initializer_list<TextMenuItem*>{&equalToValue, &increased, &decreased, &changed, &unchanged})
+	{
+		item->setActive(search.isActive());
+	}
+	resultItems.clear();
+	if(search.isActive())
+	{
+		resultsHeading.compile(std::format("Results ({} Candidates)", search.candidateCount()));
+		auto hexDigits = search.valueBytes() * 2;
+		for(auto r : search.results(maxListedResults))
+		{
+			resultItems.emplace_back(std::format("{:06X}: {} (0x{:0{}X})", r.address, r.value, r.value, hexDigits), attachParams());
+		}
+	}
+	else
+	{
+		resultsHeading.compile("Results");
+	}
+	menuItems.clear();
+	menuItems.emplace_back(&valueSize);
+	menuItems.emplace_back(&newSearch);
+	menuItems.emplace_back(&filtersHeading);
+	menuItems.emplace_back(&equalToValue);
+	menuItems.emplace_back(&increased);
+	menuItems.emplace_back(&decreased);
+	menuItems.emplace_back(&changed);
+	menuItems.emplace_back(&unchanged);
+	menuItems.emplace_back(&resultsHeading);
+	for(auto &i : resultItems)
+		menuItems.emplace_back(&i);
+}
+
+}
@@ -67,6 +67,24 @@ RecentContentView::RecentContentView(ViewAttachParams attach, RecentContent &rec
 			});
 	}
 	clear.setActive(recentContent_.size());
+	prefetch(0);
+}
+
+bool RecentContentView::inputEvent(const Input::Event &e, ViewInputEventParams p)
+{
+	auto handled = TableView::inputEvent(e, p);
+	// start reading whichever entry gets highlighted since it's the likeliest to be opened next
+	if(highlightedCell() >= 0)
+		prefetch(highlightedCell());
+	return handled;
+}
+
+void RecentContentView::prefetch(size_t idx)
+{
+	if(!app().prefetchesContent || idx >= recentContent.size())
+		return;
+	auto &entry = *(recentContent.begin() + idx);
+	app().contentPrefetcher.prefetch(entry.path, entry.name);
 }
 
 }
@@ -28,11 +28,14 @@ class RecentContentView : public TableView, public EmuAppHelper
 {
 public:
 	RecentContentView(ViewAttachParams attach, RecentContent &);
+	bool inputEvent(const Input::Event&, ViewInputEventParams p = {}) final;
 
 private:
 	std::vector<TextMenuItem> recentItems{};
 	TextMenuItem clear{};
 	RecentContent &recentContent;
+
+	void prefetch(size_t idx);
 };
 
 }
@@ -180,6 +180,25 @@ SystemActionsView::SystemActionsView(ViewAttachParams attach, bool customMenu):
 				}), e);
 		}
 	},
+	recordVideo
+	{
+		"Start Recording", attach,
+		[this]
+		{
+			if(!system().hasContent())
+				return;
+			if(app().isRecording())
+			{
+				app().stopRecording();
+				app().postMessage("Stopped recording");
+			}
+			else if(!app().startRecording())
+			{
+				return;
+			}
+			recordVideo.compile(app().isRecording() ? "Stop Recording" : "Start Recording");
+		}
+	},
 	resetSessionOptions
 	{
 		"Reset Saved Options", attach,
@@ -226,6 +245,7 @@ void SystemActionsView::onShow()
 	autosaveNow.setActive(app().autosaveManager.slotName() != noAutosaveName);
 	revertAutosave.setActive(app().autosaveManager.slotName() != noAutosaveName);
 	resetSessionOptions.setActive(app().hasSavedSessionOptions());
+	recordVideo.compile(app().isRecording() ? "Stop Recording" : "Start Recording");
 }
 
 void SystemActionsView::loadStandardItems()
@@ -243,6 +263,7 @@ void SystemActionsView::loadStandardItems()
 	if(used(addLauncherIcon))
 		item.emplace_back(&addLauncherIcon);
 	item.emplace_back(&screenshot);
+	item.emplace_back(&recordVideo);
 	item.emplace_back(&resetSessionOptions);
 	item.emplace_back(&close);
 }
@@ -29,6 +29,7 @@
 #include <mednafen/MemoryStream.h>
 #include <mednafen/cdrom/CDInterface.h>
 #include <main/MainSystem.hh>
+#include <algorithm>
 #include <string_view>
 
 namespace Mednafen
@@ -41,6 +42,46 @@ struct DriveMediaStatus
 	uint32 orientation_idx{};
 };
 
+// Write-only stream that discards data and only tracks the furthest position written,
+// used to measure a save state without buffering it
+class SizeCountStream final : public Stream
+{
+public:
+	uint64 attributes() override { return ATTRIBUTE_WRITEABLE | ATTRIBUTE_SEEKABLE; }
+	uint64 read(void *, uint64, bool) override { throw MDFN_Error(0, "SizeCountStream is write-only"); }
+
+	void write(const void *, uint64 count) override
+	{
+		pos += count;
+		size_ = std::max(size_, pos);
+	}
+
+	void truncate(uint64 length) override
+	{
+		size_ = length;
+		pos = std::min(pos, length);
+	}
+
+	void seek(int64 offset, int whence) override
+	{
+		switch(whence)
+		{
+			case SEEK_SET: pos = offset; break;
+			case SEEK_CUR: pos += offset; break;
+			case SEEK_END: pos = size_ + offset; break;
+		}
+	}
+
+	uint64 tell() override { return pos; }
+	uint64 size() override { return size_; }
+	void flush() override {}
+	void close() override {}
+
+private:
+	uint64 pos{};
+	uint64 size_{};
+};
+
 }
 
 namespace EmuEx
@@ -169,7 +210,7 @@ inline void runFrame(EmuSystem &sys, Mednafen::MDFNGI &mdfnGameInfo, EmuSystemTa
 inline size_t stateSizeMDFN()
 {
 	using namespace Mednafen;
-	MemoryStream s;
+	SizeCountStream s;
 	MDFNSS_SaveSM(&s);
 	return s.size();
 }
@@ -209,7 +250,7 @@ inline size_t writeStateMDFN(std::span<uint8_t> buff, SaveStateFlags flags)
 	}
 	else
 	{
-		MemoryStream s;
+		MemoryStream s{buff.size()}; // buffer is sized from stateSizeMDFN() so the stream shouldn't need to grow
 		MDFNSS_SaveSM(&s);
 		return compressGzip(buff, {s.map(), size_t(s.size())}, MDFN_GetSettingI("filesys.state_comp_level"));
 	}
@@ -17,6 +17,7 @@
 #include <mednafen/MThreading.h>
 #include <imagine/util/utility.h>
 #include <imagine/thread/Semaphore.hh>
+#include <imagine/thread/ThreadRegistry.hh>
 #include <imagine/logger/logger.h>
 #include <thread>
 #include <mutex>
@@ -27,9 +28,10 @@ namespace Mednafen::MThreading
 
 constexpr IG::SystemLogger log{"MDFNThreading"};
 
-struct Thread : public std::thread
+struct Thread
 {
-	using thread::thread;
+	std::thread thread;
+	IG::ThreadId id{};
 };
 struct Mutex : public std::mutex {};
 struct Cond : public std::condition_variable {};
@@ -38,20 +40,32 @@ struct Sem : public std::counting_semaphore<0x80000>
 	using counting_semaphore<0x80000>::counting_semaphore;
 };
 
-Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name)
+Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name, ThreadRole role)
 {
-	return new Thread{fn, data};
+	auto t = new Thread;
+	t->thread = IG::makeThreadSync([=](auto &sem)
+	{
+		t->id = IG::thisThreadId();
+		auto registration = IG::helperThreads().registerThisThread(debug_name ?: "MDFN Thread",
+			role == THREAD_ROLE_BACKGROUND ? IG::ThreadRole::background : IG::ThreadRole::frame);
+		sem.release();
+		fn(data);
+	});
+	return t;
 }
 
 void Thread_Wait(Thread* thread, int* status)
 {
-	thread->join();
+	thread->thread.join();
 	delete thread;
 }
 
 uint64 Thread_SetAffinity(Thread* thread, const uint64 mask)
 {
-	return 0;
+	assumeExpr(thread);
+	auto prevMask = IG::threadCPUAffinityMask(thread->id);
+	IG::setThreadCPUAffinityMask(std::span{&thread->id, 1}, IG::CPUMask(mask));
+	return prevMask;
 }
 
 Mutex* Mutex_Create(void)
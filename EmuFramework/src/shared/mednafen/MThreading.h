@@ -49,7 +49,13 @@ struct Sem;
 //
 // Thread creation/attributes
 //
-Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name = nullptr);
+enum ThreadRole : uint8
+{
+ THREAD_ROLE_FRAME,	// does work needed to produce each frame
+ THREAD_ROLE_BACKGROUND	// I/O or other work not tied to frame timing
+};
+
+Thread* Thread_Create(int (*fn)(void *), void *data, const char* debug_name = nullptr, ThreadRole role = THREAD_ROLE_FRAME);
 void Thread_Wait(Thread *thread, int *status);
 uintptr_t Thread_ID(void);
 uint64 Thread_SetAffinity(Thread* thread, uint64 mask) MDFN_COLD;
@@ -283,7 +283,7 @@ CDInterface_MT::CDInterface_MT(std::unique_ptr<CDAccess> cda, const uint64 affin
 
   UnrecoverableError = false;
 
-  CDReadThread = MThreading::Thread_Create(ReadThreadStart_C, this, "MDFN CD Read");
+  CDReadThread = MThreading::Thread_Create(ReadThreadStart_C, this, "MDFN CD Read", MThreading::THREAD_ROLE_BACKGROUND);
   EmuThreadQueue.Read(&msg);
   //
   //
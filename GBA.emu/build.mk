@@ -42,6 +42,7 @@ main/input.cc \
 main/EmuMenuViews.cc \
 main/VbamApi.cc \
 main/Cheats.cc \
+main/GBALineRenderer.cc \
 $(addprefix $(vbamPath)/,$(vbamSrc))
 
 include $(EMUFRAMEWORK_PATH)/package/emuframework.mk
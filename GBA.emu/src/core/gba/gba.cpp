@@ -542,10 +542,10 @@ int romSize = SIZE_ROM;
 #define DISPSTAT gba.mem.ioMem.DISPSTAT
 #define VCOUNT gba.mem.ioMem.VCOUNT
 #define layerEnableDelay gba.lcd.layerEnableDelay
-#define layerEnable gba.lcd.layerEnable
+#define layerEnable gba.lcd.pendingLayerEnable
 #define windowOn gba.lcd.windowOn
-#define gfxBG2Changed gba.lcd.gfxBG2Changed
-#define gfxBG3Changed gba.lcd.gfxBG3Changed
+#define gfxBG2Changed gba.lcd.pendingBG2Changed
+#define gfxBG3Changed gba.lcd.pendingBG3Changed
 #define gfxInWin0 gba.lcd.gfxInWin0
 #define gfxInWin1 gba.lcd.gfxInWin1
 #define fxOn gba.lcd.fxOn
@@ -637,6 +637,7 @@ inline int CPUUpdateTicks(ARM7TDMI &cpu)
 
 static void CPUUpdateWindow0(GBASys &gba)
 {
+  gba.lcd.syncLines();
   int x00 = WIN0H >> 8;
   int x01 = WIN0H & 255;
 
@@ -653,6 +654,7 @@ static void CPUUpdateWindow0(GBASys &gba)
 
 static void CPUUpdateWindow1(GBASys &gba)
 {
+  gba.lcd.syncLines();
   int x00 = WIN1H >> 8;
   int x01 = WIN1H & 255;
 
@@ -700,6 +702,7 @@ static void CPUUpdateWindow1(GBASys &gba)
 
 void CPUUpdateRenderBuffers(GBASys &gba, bool force)
 {
+  gba.lcd.syncLines();
   if (!(layerEnable & 0x0100) || force) {
     CLEAR_ARRAY(g_line0);
   }
@@ -2412,6 +2415,9 @@ void doDMA(GBASys &gba, ARM7TDMI &cpu, uint32_t &s, uint32_t &d, uint32_t si, ui
   cpuDmaRunning = true;
   cpuDmaPC = reg[15].I;
   cpuDmaCount = c;
+  // sync once for the whole transfer so each unit written to VRAM, palette, or OAM doesn't re-check
+  if (dm >= 0x05 && dm <= 0x07)
+    gba.lcd.syncLines();
   // This is done to get the correct waitstates.
   if (sm > 15)
       sm = 15;
@@ -3716,6 +3722,7 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
 {
 	auto cpu = gba.cpu;
 	auto restoreCpu = IG::scopeGuard([&](){ gba.cpu = cpu; });
+	auto syncLines = IG::scopeGuard([&](){ gba.lcd.syncLines(); });
 	auto &holdState = cpu.holdState;
 	auto &armIrqEnable = cpu.armIrqEnable;
 	auto &ioMem = gba.mem.ioMem;
@@ -4053,13 +4060,14 @@ void CPULoop(GBASys &gba, EmuEx::EmuSystemTaskContext taskCtx, EmuEx::EmuVideo *
             	else
             	{
             	}*/
-              (*gba.lcd.renderLine)(gba.lcd.lineMix, gba.lcd, ioMem);
+              gba.lcd.drawLine(ioMem);
             }
             if (VCOUNT == 159)
             {
             	cpuBreakLoop = true;
               if (video)
               {
+            	  gba.lcd.syncLines();
             	  systemDrawScreen(taskCtx, *video);
             	  video = nullptr;
               }
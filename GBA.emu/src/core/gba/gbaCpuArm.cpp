@@ -2846,6 +2846,40 @@ static void tester(void) {
 }
 #endif
 
+// Bitmask for each condition code of the NZCV flag combinations (N = bit 3, V = bit 0)
+// that pass it, so checking a condition is a table lookup instead of a switch
+static constexpr auto armConditionTable = []
+{
+    std::array<uint16_t, 16> table{};
+    for (unsigned cond = 0; cond < 16; cond++) {
+        for (unsigned flags = 0; flags < 16; flags++) {
+            bool n = flags & 8, z = flags & 4, c = flags & 2, v = flags & 1;
+            bool res{};
+            switch (cond) {
+              case 0x00: res = z; break; // EQ
+              case 0x01: res = !z; break; // NE
+              case 0x02: res = c; break; // CS
+              case 0x03: res = !c; break; // CC
+              case 0x04: res = n; break; // MI
+              case 0x05: res = !n; break; // PL
+              case 0x06: res = v; break; // VS
+              case 0x07: res = !v; break; // VC
+              case 0x08: res = c && !z; break; // HI
+              case 0x09: res = !c || z; break; // LS
+              case 0x0A: res = n == v; break; // GE
+              case 0x0B: res = n != v; break; // LT
+              case 0x0C: res = !z && (n == v); break; // GT
+              case 0x0D: res = z || (n != v); break; // LE
+              case 0x0E: res = true; break; // AL
+              case 0x0F: res = false; break; // NV
+            }
+            if (res)
+                table[cond] |= 1 << flags;
+        }
+    }
+    return table;
+}();
+
 int armExecute(ARM7TDMI &cpu)
 {
 	int &cpuNextEvent = cpu.cpuNextEvent;
@@ -2892,60 +2926,8 @@ int armExecute(ARM7TDMI &cpu)
         int cond = opcode >> 28;
         bool cond_res = true;
         if (UNLIKELY(cond != 0x0E)) {  // most opcodes are AL (always)
-            switch (cond) {
-              case 0x00: // EQ
-                cond_res = Z_FLAG;
-                break;
-              case 0x01: // NE
-                cond_res = !Z_FLAG;
-                break;
-              case 0x02: // CS
-                cond_res = C_FLAG;
-                break;
-              case 0x03: // CC
-                cond_res = !C_FLAG;
-                break;
-              case 0x04: // MI
-                cond_res = N_FLAG;
-                break;
-              case 0x05: // PL
-                cond_res = !N_FLAG;
-                break;
-              case 0x06: // VS
-                cond_res = V_FLAG;
-                break;
-              case 0x07: // VC
-                cond_res = !V_FLAG;
-                break;
-              case 0x08: // HI
-                cond_res = C_FLAG && !Z_FLAG;
-                break;
-              case 0x09: // LS
-                cond_res = !C_FLAG || Z_FLAG;
-                break;
-              case 0x0A: // GE
-                cond_res = N_FLAG == V_FLAG;
-                break;
-              case 0x0B: // LT
-                cond_res = N_FLAG != V_FLAG;
-                break;
-              case 0x0C: // GT
-                cond_res = !Z_FLAG && (N_FLAG == V_FLAG);
-                break;
-              case 0x0D: // LE
-                cond_res = Z_FLAG || (N_FLAG != V_FLAG);
-                break;
-              /*case 0x0E: // AL (impossible, checked above)
-                cond_res = true;
-                break;*/
-              case 0x0F:
-              	cond_res = false;
-              	break;
-              default:
-                // ???
-              	bug_unreachable("invalid condition:0x%X", cond);
-                break;
-            }
+            unsigned flags = (N_FLAG << 3) | (Z_FLAG << 2) | (C_FLAG << 1) | V_FLAG;
+            cond_res = (armConditionTable[cond] >> flags) & 1;
         }
 
         if (cond_res)
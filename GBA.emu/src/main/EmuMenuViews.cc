@@ -406,6 +406,16 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 		}
 	};
 
+	BoolMenuItem threadedRendering
+	{
+		"Threaded Rendering", attachParams(),
+		system().threadedRendering,
+		[this](BoolMenuItem &item)
+		{
+			system().threadedRendering = item.flipBoolValue(*this);
+		}
+	};
+
 	#ifdef IG_CONFIG_SENSORS
 	TextMenuItem lightSensorScaleItem[5]
 	{
@@ -453,6 +463,8 @@ public:
 	{
 		loadStockItems();
 		item.emplace_back(&bios);
+		if(appContext().cpuCount() > 1)
+			item.emplace_back(&threadedRendering);
 		#ifdef IG_CONFIG_SENSORS
 		item.emplace_back(&lightSensorScale);
 		#endif
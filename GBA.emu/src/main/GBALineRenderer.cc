@@ -0,0 +1,80 @@
+/*  This file is part of GBA.emu.
+
+	GBA.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBA.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBA.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "GBALineRenderer.hh"
+#include <imagine/thread/ThreadRegistry.hh>
+#include <algorithm>
+#include <cstddef>
+
+// LCD registers up to and including COLY, the renderers don't read any others
+constexpr size_t lcdRegsSize = offsetof(GBAMem::IoMem, COLY) + sizeof(uint16_t);
+
+GBALineRenderer::GBALineRenderer(GBALCD &lcd)
+{
+	thread = IG::makeThreadSync([this, &lcd](auto &sem)
+	{
+		auto registration = IG::helperThreads().registerThisThread("GBA Line Renderer");
+		sem.release();
+		for(;;)
+		{
+			auto span = lines.beginRead(1, {.blocking = true});
+			if(span.empty())
+				continue;
+			auto &line = span[0];
+			if(!line.renderLine)
+				break;
+			lcd.layerEnable = line.layerEnable;
+			lcd.gfxBG2Changed = line.gfxBG2Changed;
+			lcd.gfxBG3Changed = line.gfxBG3Changed;
+			line.renderLine(line.lineMix, lcd, line.ioMem);
+			lines.endRead(span);
+			lines.notifyRead();
+		}
+	});
+}
+
+GBALineRenderer::~GBALineRenderer()
+{
+	auto span = lines.beginWrite(1, {.blocking = true});
+	span[0].renderLine = nullptr;
+	lines.endWrite(span);
+	lines.notifyWrite();
+	thread.join();
+}
+
+void GBALineRenderer::post(GBALCD &lcd, const GBAMem::IoMem &ioMem)
+{
+	auto span = lines.beginWrite(1, {.blocking = true});
+	auto &line = span[0];
+	line.renderLine = lcd.renderLine;
+	line.lineMix = lcd.lineMix;
+	line.layerEnable = lcd.pendingLayerEnable;
+	line.gfxBG2Changed = std::exchange(lcd.pendingBG2Changed, 0);
+	line.gfxBG3Changed = std::exchange(lcd.pendingBG3Changed, 0);
+	std::copy_n(ioMem.b, lcdRegsSize, line.ioMem.b);
+	lines.endWrite(span);
+	if(lines.size() >= flushLines)
+		lines.notifyWrite();
+}
+
+void GBALCD::queueLine(const GBAMem::IoMem &ioMem)
+{
+	lineRenderer->post(*this, ioMem);
+}
+
+void GBALCD::waitForQueuedLines()
+{
+	lineRenderer->wait();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+/*  This file is part of GBA.emu.
+
+	GBA.emu is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	GBA.emu is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with GBA.emu.  If not, see <http://www.gnu.org/licenses/> */
+
+#include "GBASys.hh"
+#include <imagine/thread/Thread.hh>
+#include <imagine/util/container/RingBuffer.hh>
+#include <thread>
+
+// State a line render reads that the CPU can change before the line is drawn
+struct GBALineState
+{
+	GBALCD::RenderLineFunc renderLine{};
+	MixColorType *lineMix{};
+	unsigned layerEnable{};
+	int gfxBG2Changed{};
+	int gfxBG3Changed{};
+	GBAMem::IoMem ioMem; // only the LCD registers are copied
+};
+
+// Renders latched scanlines on a helper thread while the CPU emulates the following lines,
+// CPU writes to VRAM, palette, or OAM wait for any queued lines to finish first
+class GBALineRenderer
+{
+public:
+	GBALineRenderer(GBALCD &);
+	~GBALineRenderer();
+	void post(GBALCD &, const GBAMem::IoMem &);
+	void wait() { lines.waitForSize(0); }
+
+private:
+	static constexpr size_t flushLines = 8;
+	IG::RingBuffer<GBALineState, {.fixedSize = 64}> lines;
+	std::thread thread;
+};
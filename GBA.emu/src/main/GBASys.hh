@@ -8,6 +8,7 @@
 
 using MixColorType = uint16_t;
 struct GBALCD;
+class GBALineRenderer;
 
 struct GBAMem
 {
@@ -275,6 +276,12 @@ struct GBALCD
 	unsigned layerEnable{};
 	int gfxBG2Changed{};
 	int gfxBG3Changed{};
+	// CPU side copies of the above, latched when a line is drawn
+	unsigned pendingLayerEnable{};
+	int pendingBG2Changed{};
+	int pendingBG3Changed{};
+	GBALineRenderer *lineRenderer{};
+	bool linesQueued{}; // lines were posted to lineRenderer since the last sync
 	int gfxBG2X{};
 	int gfxBG2Y{};
 	int gfxBG3X{};
@@ -285,6 +292,7 @@ struct GBALCD
 
 	void registerRamReset(uint32_t flags)
 	{
+		syncLines();
     if(flags & 0x04) {
       // clear palette RAM
       memset(paletteRAM, 0, 0x400);
@@ -311,8 +319,36 @@ struct GBALCD
 	{
 		reset();
 		ioMem.resetLcdRegs(useBios, skipBios);
-		layerEnable = ioMem.DISPCNT & coreOptions.layerSettings;
+		layerEnable = pendingLayerEnable = ioMem.DISPCNT & coreOptions.layerSettings;
 	}
+
+	void drawLine(const GBAMem::IoMem &ioMem)
+	{
+		if(lineRenderer)
+		{
+			queueLine(ioMem);
+			linesQueued = true;
+			return;
+		}
+		layerEnable = pendingLayerEnable;
+		gfxBG2Changed = std::exchange(pendingBG2Changed, 0);
+		gfxBG3Changed = std::exchange(pendingBG3Changed, 0);
+		renderLine(lineMix, *this, ioMem);
+	}
+
+	// call before the CPU modifies state read by the line renderers, only waits
+	// on the first write after a line is queued so later writes are just a flag test
+	void syncLines()
+	{
+		if(linesQueued) [[unlikely]]
+		{
+			waitForQueuedLines();
+			linesQueued = false;
+		}
+	}
+
+	void queueLine(const GBAMem::IoMem &);
+	void waitForQueuedLines();
 };
 
 const char *dispModeName(GBALCD::RenderLineFunc);
@@ -161,6 +161,8 @@ void GbaSystem::closeSystem()
 	sensorListener = {};
 	darknessLevel = darknessLevelDefault;
 	cheatsList.clear();
+	gGba.lcd.lineRenderer = {};
+	lineRenderer.reset();
 }
 
 void GbaSystem::applyGamePatches(uint8_t *rom, int &romSize)
@@ -260,6 +262,17 @@ void GbaSystem::configAudioRate(FrameTime outputFrameTime, int outputRate)
 void GbaSystem::onStart()
 {
 	setSensorActive(true);
+	updateLineRenderer();
+}
+
+void GbaSystem::updateLineRenderer()
+{
+	bool useThread = threadedRendering;
+	if(useThread == bool(lineRenderer))
+		return;
+	log.info("{} line render thread", useThread ? "starting" : "stopping");
+	lineRenderer = useThread ? std::make_unique<GBALineRenderer>(gGba.lcd) : nullptr;
+	gGba.lcd.lineRenderer = lineRenderer.get();
 }
 
 void GbaSystem::onStop()
@@ -21,6 +21,8 @@
 #include <imagine/io/FileIO.hh>
 #include <imagine/util/enum.hh>
 #include <core/gba/gba.h>
+#include "GBALineRenderer.hh"
+#include <memory>
 
 namespace IG
 {
@@ -42,7 +44,7 @@ enum
 	CFGKEY_SENSOR_TYPE = 262, CFGKEY_LIGHT_SENSOR_SCALE = 263,
 	CFGKEY_CHEATS_PATH = 264, CFGKEY_PATCHES_PATH = 265,
 	CFGKEY_USE_BIOS = 266, CFGKEY_DEFAULT_USE_BIOS = 267,
-	CFGKEY_BIOS_PATH = 268
+	CFGKEY_BIOS_PATH = 268, CFGKEY_THREADED_RENDERING = 269
 };
 
 void readCheatFile(class EmuSystem &);
@@ -90,6 +92,8 @@ public:
 	bool saveMemoryIsMappedFile{};
 	Property<AutoTristate, CFGKEY_USE_BIOS> useBios;
 	Property<bool, CFGKEY_DEFAULT_USE_BIOS> defaultUseBios;
+	Property<bool, CFGKEY_THREADED_RENDERING> threadedRendering;
+	std::unique_ptr<GBALineRenderer> lineRenderer;
 	ConditionalMember<Config::SENSORS, GbaSensorType> sensorType{};
 	ConditionalMember<Config::SENSORS, GbaSensorType> detectedSensorType{};
 	static constexpr auto gbaFrameTime{fromSeconds<FrameTime>(280896. / 16777216.)}; // ~59.7275Hz
@@ -103,6 +107,7 @@ public:
 	void setSensorActive(bool);
 	void setSensorType(GbaSensorType);
 	void clearSensorValues();
+	void updateLineRenderer();
 
 	// required API functions
 	void loadContent(IO &, EmuSystemCreateParams, OnLoadProgressDelegate);
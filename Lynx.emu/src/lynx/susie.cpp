@@ -52,6 +52,7 @@
 #include "system.h"
 #include "susie.h"
 #include "lynxdef.h"
+#include <algorithm>
 
 //
 // As the Susie sprite engine only ever sees system RAM
@@ -621,8 +622,8 @@ uint32 CSusie::PaintSprites(void)
 				int pixel_width;
 				int pixel;
 				int hoff,voff;
-				int hloop,vloop;
-				bool onscreen;
+				int vloop;
+				bool onscreen,offscreen;
 
 				if(render)
 				{
@@ -695,6 +696,7 @@ uint32 CSusie::PaintSprites(void)
 								// Initialise our line
 								LineInit(voff);
 								onscreen=false;
+								offscreen=false;
 
 								// Now render an individual destination line
 								while((pixel=LineGetPixel())!=LINE_END)
@@ -704,21 +706,46 @@ uint32 CSusie::PaintSprites(void)
 									pixel_width=mHSIZACUM.Union8.High;
 									mHSIZACUM.Union8.High=0;
 
-									for(hloop=0;hloop<pixel_width;hloop++)
+									// Packed runs repeat the pixel without reading more data,
+									// fold the rest of the run into the same span
+									while(mLineType==line_packed && mLineRepeatCount)
 									{
-										// Draw if onscreen but break loop on transition to offscreen
-										if(hoff>=0 && hoff<SCREEN_WIDTH)
-										{
-											ProcessPixel(hoff,pixel);
-											onscreen = true;
-											everonscreen = true;
-										}
-										else
-										{
-											if(onscreen) break;
-										}
-										hoff+=hsign;
+										mLineRepeatCount--;
+										mHSIZACUM.Val16+=mSPRHSIZ.Val16;
+										pixel_width+=mHSIZACUM.Union8.High;
+										mHSIZACUM.Union8.High=0;
 									}
+
+									// Once the line leaves the screen nothing else on it is drawn,
+									// but keep decoding so the data reads are still counted
+									if(offscreen) continue;
+
+									// Skip the part of the span before the screen edge it's moving towards
+									int first=0;
+									if(!onscreen)
+									{
+										if(hsign==1) first=hoff<0 ? -hoff : (hoff>=SCREEN_WIDTH ? pixel_width : 0);
+										else first=hoff>=SCREEN_WIDTH ? hoff-(SCREEN_WIDTH-1) : (hoff<0 ? pixel_width : 0);
+										if(first>pixel_width) first=pixel_width;
+									}
+
+									int start=hoff+first*hsign;
+									int visible=0;
+									if(first<pixel_width && start>=0 && start<SCREEN_WIDTH)
+										visible=std::min(pixel_width-first, hsign==1 ? SCREEN_WIDTH-start : start+1);
+
+									if(visible)
+									{
+										ProcessSpan(start,visible,hsign,pixel);
+										onscreen = true;
+										everonscreen = true;
+									}
+
+									// Stop drawing on the transition to offscreen
+									if(onscreen && first+visible<pixel_width)
+										offscreen = true;
+									else
+										hoff+=pixel_width*hsign;
 								}
 							}
 							voff+=vsign;
@@ -999,6 +1026,68 @@ INLINE uint32 CSusie::LineGetBits(uint32 bits)
 //                        1 0 0 0 0 0 0 0   exclusive-or the data 
 //
 
+// Writes a run of identical pixels, opaque sprites that don't touch the collision
+// buffer reduce to a nibble fill, other types go pixel by pixel
+void CSusie::ProcessSpan(int hoff,int count,int hsign,uint32 pixel)
+{
+	switch(mSPRCTL0_Type)
+	{
+		case sprite_noncollide:
+			if(pixel==0x00) return;
+			WritePixelSpan(hoff,count,hsign,pixel);
+			return;
+
+		case sprite_background_noncollide:
+			WritePixelSpan(hoff,count,hsign,pixel);
+			return;
+
+		case sprite_normal:
+			if(pixel==0x00) return;
+			if(mSPRCOLL_Collide || mSPRSYS_NoCollide)
+			{
+				WritePixelSpan(hoff,count,hsign,pixel);
+				return;
+			}
+			break;
+	}
+
+	for(;count;count--,hoff+=hsign)
+	{
+		ProcessPixel(hoff,pixel);
+	}
+}
+
+// Same as calling WritePixel() for each pixel but writes both nibbles of a byte at once
+INLINE void CSusie::WritePixelSpan(int hoff,int count,int hsign,uint32 pixel)
+{
+	uint32 pos=hsign==1 ? hoff : hoff-count+1;
+	const uint32 end=pos+count;
+
+	// Increment cycle count for the read/modify/write of each pixel
+	cycles_used+=count*2*SPR_RDWR_CYC;
+
+	if(pos&0x01)
+	{
+		// Leading lower nibble
+		const uint16 scr_addr=mLineBaseAddress+(pos/2);
+		RAM_POKE(scr_addr,(RAM_PEEK(scr_addr)&0xf0)|pixel);
+		pos++;
+	}
+
+	const uint8 pair=pixel*0x11;
+	for(;pos+1<end;pos+=2)
+	{
+		RAM_POKE(mLineBaseAddress+(pos/2),pair);
+	}
+
+	if(pos<end)
+	{
+		// Trailing upper nibble
+		const uint16 scr_addr=mLineBaseAddress+(pos/2);
+		RAM_POKE(scr_addr,(RAM_PEEK(scr_addr)&0x0f)|(pixel<<4));
+	}
+}
+
 //inline 
 void CSusie::ProcessPixel(uint32 hoff,uint32 pixel)
 {
@@ -338,6 +338,8 @@ class CSusie : public CLynxBase
 		uint32	LineGetBits(uint32 bits);
 
 		void	ProcessPixel(uint32 hoff,uint32 pixel);
+		void	ProcessSpan(int hoff,int count,int hsign,uint32 pixel);
+		void	WritePixelSpan(int hoff,int count,int hsign,uint32 pixel);
 		void	WritePixel(uint32 hoff,uint32 pixel);
 		uint32	ReadPixel(uint32 hoff);
 		void	WriteCollision(uint32 hoff,uint32 pixel);
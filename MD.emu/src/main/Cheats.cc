@@ -38,7 +38,7 @@ namespace EmuEx
 
 StaticArrayList<MdCheat, maxCheats> cheatList;
 StaticArrayList<MdCheat*, maxCheats> romCheatList;
-StaticArrayList<MdCheat*, maxCheats> ramCheatList;
+CheatPatchList ramCheatPatches;
 static const char *INPUT_CODE_8BIT_STR = "Input xxx-xxx-xxx (GG) or xxxxxx:xx (AR) code";
 static const char *INPUT_CODE_16BIT_STR = "Input xxxx-xxxx (GG) or xxxxxx:xxxx (AR) code";
 
@@ -327,14 +327,17 @@ void applyCheats()
       else if(e.address >= 0xFF0000)
       {
         // add RAM patch
-      	ramCheatList.push_back(&e);
+        if(e.data & 0xFF00)
+          ramCheatPatches.add(work_ram, e.address & 0xFFFE, e.data, 2); // word patch
+        else
+          ramCheatPatches.add(work_ram, e.address & 0xFFFF, e.data, 1); // byte patch
       }
       e.setApplied(1);
     }
   }
-  if(romCheatList.size() || ramCheatList.size())
+  if(romCheatList.size() || ramCheatPatches.size())
   {
-  	logMsg("%zu RAM cheats, %zu ROM cheats active", ramCheatList.size(), romCheatList.size());
+  	logMsg("%zu RAM cheats, %zu ROM cheats active", ramCheatPatches.size(), romCheatList.size());
   }
 }
 
@@ -342,7 +345,7 @@ void clearCheats()
 {
 	//logMsg("clearing cheats");
 	romCheatList.clear();
-	ramCheatList.clear();
+	ramCheatPatches.clear();
 
 	//logMsg("reversing applied cheats");
   // disable cheats in reversed order in case the same address is used by multiple patches
@@ -380,7 +383,7 @@ void clearCheats()
 void clearCheatList()
 {
 	romCheatList.clear();
-	ramCheatList.clear();
+	ramCheatPatches.clear();
 	cheatList.clear();
 }
 
@@ -479,20 +482,7 @@ void readCheatFile(EmuSystem &sys_)
 
 void RAMCheatUpdate()
 {
-	for(auto &e : ramCheatList)
-	{
-		// apply RAM patch
-		if(e->data & 0xFF00)
-		{
-			// word patch
-			*(uint16*)(work_ram + (e->address & 0xFFFE)) = e->data;
-		}
-		else
-		{
-			// byte patch
-			work_ram[e->address & 0xFFFF] = e->data;
-		}
-	}
+	ramCheatPatches.apply();
 }
 
 EmuEditCheatView::EmuEditCheatView(ViewAttachParams attach, MdCheat &cheat_, RefreshCheatsDelegate onCheatListChanged_):
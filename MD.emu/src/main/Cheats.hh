@@ -19,6 +19,7 @@
 #include <imagine/util/bit.hh>
 #include <imagine/util/string.h>
 #include <emuframework/EmuSystem.hh>
+#include <emuframework/CheatPatchList.hh>
 
 namespace EmuEx
 {
@@ -76,7 +77,7 @@ void RAMCheatUpdate();
 static constexpr size_t maxCheats = 100;
 extern StaticArrayList<MdCheat, maxCheats> cheatList;
 extern StaticArrayList<MdCheat*, maxCheats> romCheatList;
-extern StaticArrayList<MdCheat*, maxCheats> ramCheatList;
+extern CheatPatchList ramCheatPatches;
 
 }
 
@@ -118,6 +118,15 @@ void MdSystem::renderFramebuffer(EmuVideo &video)
 
 VideoSystem MdSystem::videoSystem() const { return vdp_pal ? VideoSystem::PAL : VideoSystem::NATIVE_NTSC; }
 
+std::span<const MemoryRegion> MdSystem::memoryRegions()
+{
+	static const MemoryRegion mdRegions[]{{"68K RAM", work_ram, 0xFF0000, true}, {"Z80 RAM", zram, 0xA00000}};
+	static const MemoryRegion smsRegions[]{{"RAM", {work_ram, 0x2000}, 0xC000}};
+	if(emuSystemIs16Bit())
+		return mdRegions;
+	return smsRegions;
+}
+
 void MdSystem::reset(EmuApp &, ResetMode mode)
 {
 	assert(hasContent());
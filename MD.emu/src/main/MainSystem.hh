@@ -103,6 +103,7 @@ public:
 		Input::DragTrackerState prevDragState, IG::WindowRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, IG::WindowRect gameRect);
 	VideoSystem videoSystem() const;
+	std::span<const MemoryRegion> memoryRegions();
 
 private:
 	void setupSmsInput(EmuApp &);
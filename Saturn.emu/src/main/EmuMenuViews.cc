@@ -533,6 +533,7 @@ public:
 class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 {
 	using MainAppHelper::system;
+	using MainAppHelper::app;
 
 	BoolMenuItem autoSetRTC
 	{
@@ -569,6 +570,33 @@ class CustomSystemOptionView : public SystemOptionView, public MainAppHelper
 
 	BoolMenuItem saveFilenameType = saveFilenameTypeMenuItem(*this, system());
 
+	TextMenuItem vdp2WorkersItems[SaturnSystem::maxVdp2Workers + 1]
+	{
+		{"Off", attachParams(), {.id = 0}},
+		{"1",   attachParams(), {.id = 1}},
+		{"2",   attachParams(), {.id = 2}},
+		{"3",   attachParams(), {.id = 3}},
+		{"4",   attachParams(), {.id = 4}},
+		{"5",   attachParams(), {.id = 5}},
+		{"6",   attachParams(), {.id = 6}},
+		{"7",   attachParams(), {.id = 7}},
+		{"8",   attachParams(), {.id = 8}},
+	};
+
+	MultiChoiceMenuItem vdp2Workers
+	{
+		"VDP2 Worker Threads", attachParams(),
+		MenuId{system().vdp2Workers},
+		vdp2WorkersItems,
+		{
+			.defaultItemOnSelect = [this](TextMenuItem &item)
+			{
+				system().vdp2Workers = item.id;
+				app().postMessage("Change takes effect next time content is loaded");
+			}
+		}
+	};
+
 public:
 	CustomSystemOptionView(ViewAttachParams attach): SystemOptionView{attach, true}
 	{
@@ -576,6 +604,8 @@ public:
 		item.emplace_back(&biosLanguage);
 		item.emplace_back(&autoSetRTC);
 		item.emplace_back(&saveFilenameType);
+		if(appContext().cpuCount() > 2)
+			item.emplace_back(&vdp2Workers);
 	}
 };
 
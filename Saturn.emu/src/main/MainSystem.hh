@@ -32,7 +32,6 @@ class CDInterface;
 namespace MDFN_IEN_SS
 {
 extern Mednafen::CDInterface* Cur_CDIF;
-extern IG::ThreadId RThreadId;
 extern const int ActiveCartType;
 extern uint8 AreaCode;
 }
@@ -85,7 +84,7 @@ enum
 	CFGKEY_DEFAULT_NTSC_VIDEO_LINES = 287, CFGKEY_DEFAULT_PAL_VIDEO_LINES = 288,
 	CFGKEY_DEFAULT_SHOW_H_OVERSCAN = 289, CFGKEY_SHOW_H_OVERSCAN = 290,
 	CFGKEY_DEINTERLACE_MODE = 291, CFGKEY_WIDESCREEN_MODE = 292,
-	CFGKEY_NO_MD5_FILENAMES = 293
+	CFGKEY_NO_MD5_FILENAMES = 293, CFGKEY_VDP2_WORKERS = 294
 };
 
 struct VideoLineRange
@@ -125,6 +124,8 @@ public:
 	uint8_t lastInterlaceMode{};
 	int8_t region{};
 	int8_t biosLanguage{MDFN_IEN_SS::SMPC_RTC_LANG_ENGLISH};
+	uint8_t vdp2Workers{};
+	static constexpr uint8_t maxVdp2Workers = 8;
 	InputConfig inputConfig{};
 	DeinterlaceMode deinterlaceMode{DeinterlaceMode::Bob};
 	bool defaultShowHOverscan{};
@@ -194,7 +195,6 @@ public:
 	bool onPointerInputStart(const Input::MotionEvent &e, Input::DragTrackerState, WRect gameRect);
 	bool onPointerInputEnd(const Input::MotionEvent &, Input::DragTrackerState, WRect);
 	Rotation contentRotation() const;
-	void addThreadGroupIds(std::vector<ThreadId> &ids) const { ids.emplace_back(MDFN_IEN_SS::RThreadId); }
 };
 
 using MainSystem = SaturnSystem;
@@ -80,6 +80,7 @@ bool SaturnSystem::readConfig(ConfigType type, MapIO &io, unsigned key)
 			case CFGKEY_DEFAULT_PAL_VIDEO_LINES: return readOptionValue(io, defaultPalLines, linesAreValid<288>);
 			case CFGKEY_DEFAULT_SHOW_H_OVERSCAN: return readOptionValue(io, defaultShowHOverscan);
 			case CFGKEY_NO_MD5_FILENAMES: return readOptionValue(io, noMD5InFilenames);
+			case CFGKEY_VDP2_WORKERS: return readOptionValue(io, vdp2Workers, [](auto v){ return v <= maxVdp2Workers; });
 		}
 	}
 	else if(type == ConfigType::SESSION)
@@ -113,6 +114,7 @@ void SaturnSystem::writeConfig(ConfigType type, FileIO &io)
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_PAL_VIDEO_LINES, defaultPalLines, safePalLines);
 		writeOptionValueIfNotDefault(io, CFGKEY_DEFAULT_SHOW_H_OVERSCAN, defaultShowHOverscan, false);
 		writeOptionValueIfNotDefault(io, CFGKEY_NO_MD5_FILENAMES, noMD5InFilenames, false);
+		writeOptionValueIfNotDefault(io, CFGKEY_VDP2_WORKERS, vdp2Workers, 0);
 	}
 	else if(type == ConfigType::SESSION)
 	{
@@ -149,6 +151,8 @@ uint64 MDFN_GetSettingUI(const char *name_)
 		return sys.biosLanguage;
 	if("ss.affinity.vdp2" == name)
 		return 0;
+	if("ss.vdp2.workers" == name)
+		return sys.vdp2Workers;
 	if(name.ends_with("gun_chairs"))
 		return 0xFFFFFFFF;
 	if(name == "ss.dbg_cem")
@@ -1366,6 +1366,7 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
  int sls = MDFN_GetSettingI(PAL ? "ss.slstartp" : "ss.slstart");
  int sle = MDFN_GetSettingI(PAL ? "ss.slendp" : "ss.slend");
  const uint64 vdp2_affinity = MDFN_GetSettingUI("ss.affinity.vdp2");
+ const unsigned vdp2_workers = MDFN_GetSettingUI("ss.vdp2.workers");
 
  if(PAL)
  {
@@ -1472,7 +1473,7 @@ static void MDFN_COLD InitCommon(unsigned cpucache_emumode, unsigned horrible_ha
   STVIO_Init(sgi);
 
  VDP1::Init();
- VDP2::Init(PAL, vdp2_affinity);
+ VDP2::Init(PAL, vdp2_affinity, vdp2_workers);
  CDB_Init();
  SOUND_Init(cart_type == CART_STV);
 
@@ -2455,6 +2456,7 @@ static const MDFNSetting SSSettings[] =
  { "ss.slendp", MDFNSF_NOFLAGS, gettext_noop("Last displayed scanline in PAL mode."), NULL, MDFNST_INT, "255", "-16", "271" },
 
  { "ss.affinity.vdp2", MDFNSF_NOFLAGS, gettext_noop("VDP2 rendering thread CPU affinity mask."), gettext_noop("Set to 0 to disable changing affinity."), MDFNST_UINT, "0", "0x0000000000000000", "0xFFFFFFFFFFFFFFFF" },
+ { "ss.vdp2.workers", MDFNSF_NOFLAGS, gettext_noop("Number of VDP2 line finishing worker threads."), gettext_noop("Set to 0 to finish lines on the VDP2 rendering thread.  Worker threads use the ss.affinity.vdp2 CPU affinity mask."), MDFNST_UINT, "0", "0", "8" },
 
 #ifdef MDFN_ENABLE_DEV_BUILD
  { "ss.dbg_mask", MDFNSF_SUPPRESS_DOC, gettext_noop("Debug printf mask."), NULL, MDFNST_MULTI_ENUM, "none", NULL, NULL, NULL, NULL, DBGMask_List },
@@ -34,6 +34,9 @@
 #include <imagine/util/container/RingBuffer.hh>
 
 #include <atomic>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 namespace MDFN_IEN_SS
 {
@@ -2618,14 +2621,14 @@ static void (*MixIt[2][7][2][2])(uint32* target, const unsigned vdp2_line, const
  {  {  { T_MixIt<1, 0, 0, 0>, T_MixIt<1, 0, 0, 1>,  },  { T_MixIt<1, 0, 1, 0>, T_MixIt<1, 0, 1, 1>,  },  },  {  { T_MixIt<1, 1, 0, 0>, T_MixIt<1, 1, 0, 1>,  },  { T_MixIt<1, 1, 1, 0>, T_MixIt<1, 1, 1, 1>,  },  },  {  { T_MixIt<1, 2, 0, 0>, T_MixIt<1, 2, 0, 1>,  },  { T_MixIt<1, 2, 1, 0>, T_MixIt<1, 2, 1, 1>,  },  },  {  { T_MixIt<1, 3, 0, 0>, T_MixIt<1, 3, 0, 1>,  },  { T_MixIt<1, 3, 1, 0>, T_MixIt<1, 3, 1, 1>,  },  },  {  { T_MixIt<1, 4, 0, 0>, T_MixIt<1, 4, 0, 1>,  },  { T_MixIt<1, 4, 1, 0>, T_MixIt<1, 4, 1, 1>,  },  },  {  { T_MixIt<1, 5, 0, 0>, T_MixIt<1, 5, 0, 1>,  },  { T_MixIt<1, 5, 1, 0>, T_MixIt<1, 5, 1, 1>,  },  },  {  { T_MixIt<1, 6, 0, 0>, T_MixIt<1, 6, 0, 1>,  },  { T_MixIt<1, 6, 1, 0>, T_MixIt<1, 6, 1, 1>,  },  },  },
 };
 
-static int32 ApplyHBlend(uint32* const target, int32 w)
+static int32 ApplyHBlend(uint32* const target, int32 w, const bool hires)
 {
  #define BHALF(m, n) ((((uint64)(m) + (n)) - (((m) ^ (n)) & 0x01010101)) >> 1)
 
  assert(w >= 4);
 
 #if 1
- if(!(HRes & 0x2))
+ if(!hires)
  {
   target[(w - 1) * 2 + 1] = target[w - 1];
   target[(w - 1) * 2 + 0] = BHALF(BHALF(target[w - 2], target[w - 1]), target[w - 1]);
@@ -2649,7 +2652,7 @@ static int32 ApplyHBlend(uint32* const target, int32 w)
  }
  else
 #else
- if(!(HRes & 0x2))
+ if(!hires)
  {
   for(int32 x = w - 1; x >= 0; x--)
    target[x * 2 + 0] = target[x * 2 + 1] = target[x];
@@ -2696,6 +2699,62 @@ static void ReorderRGB(uint32* target, const unsigned w, const unsigned Rshift,
  }
 }
 
+//
+// With ss.vdp2.workers > 0, RGB reordering and the horizontal blend filter are deferred to the end of the
+// frame and split between the worker threads, leaving only layer composition on the render thread.
+//
+struct FinishEntry
+{
+ uint32* reorder_target;	// NULL for border-only lines
+ uint16 reorder_w;
+ uint16 out_line;
+ bool hires;
+};
+
+static std::vector<MThreading::Thread*> FinishThreads;
+static MThreading::Sem* FinishStartSem = NULL;
+static MThreading::Sem* FinishDoneSem = NULL;
+static std::array<FinishEntry, 576> FinishQueue;	// one entry per output framebuffer line at most
+static unsigned FinishCount;
+static std::atomic<unsigned> FinishNext;
+static bool FinishExit;
+enum : unsigned { FinishChunkSize = 16 };
+
+static void FinishLine(const FinishEntry& fe)
+{
+ if(fe.reorder_target)
+  ReorderRGB(fe.reorder_target, fe.reorder_w, espec->surface->format.Rshift, espec->surface->format.Gshift, espec->surface->format.Bshift);
+
+ if(DoHBlend)
+  espec->LineWidths[fe.out_line] = ApplyHBlend(espec->surface->pixels + fe.out_line * espec->surface->pitchinpix + espec->DisplayRect.x, espec->LineWidths[fe.out_line], fe.hires);
+}
+
+static void FinishLines(void)
+{
+ for(unsigned i = FinishNext.fetch_add(FinishChunkSize, std::memory_order_relaxed); i < FinishCount; i = FinishNext.fetch_add(FinishChunkSize, std::memory_order_relaxed))
+ {
+  const unsigned bound = std::min<unsigned>(FinishCount, i + FinishChunkSize);
+
+  for(unsigned j = i; j < bound; j++)
+   FinishLine(FinishQueue[j]);
+ }
+}
+
+static int FinishThreadEntry(void* data)
+{
+ for(;;)
+ {
+  MThreading::Sem_Wait(FinishStartSem);
+
+  if(FinishExit)
+   break;
+
+  FinishLines();
+  MThreading::Sem_Post(FinishDoneSem);
+ }
+ return 0;
+}
+
 static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, const bool field)
 {
  if(espec->skip)
@@ -2786,6 +2845,12 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
  {
   for(int32 i = 0; i < tvdw; i++)
    target[i] = border_ncf;
+
+  if(FinishThreads.size())
+  {
+   assert(FinishCount < FinishQueue.size());
+   FinishQueue[FinishCount++] = { NULL, 0, out_line, (bool)(HRes & 0x2) };
+  }
  }
  else
  {
@@ -3151,7 +3216,14 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
    }
 
    MixIt[rbgdualen][special][CCRTMD][CCMD](target + tvxo, vdp2_line, w, back_rgb24, blursrc);
-   ReorderRGB(target + tvxo, w, espec->surface->format.Rshift, espec->surface->format.Gshift, espec->surface->format.Bshift);
+
+   if(FinishThreads.size())
+   {
+    assert(FinishCount < FinishQueue.size());
+    FinishQueue[FinishCount++] = { target + tvxo, (uint16)w, out_line, (bool)(HRes & 0x2) };
+   }
+   else
+    ReorderRGB(target + tvxo, w, espec->surface->format.Rshift, espec->surface->format.Gshift, espec->surface->format.Bshift);
   }
 
   //
@@ -3174,9 +3246,9 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
  //
  //
  //
- if(DoHBlend)
+ if(DoHBlend && !FinishThreads.size())
  {
-  espec->LineWidths[out_line] = ApplyHBlend(espec->surface->pixels + out_line * espec->surface->pitchinpix + espec->DisplayRect.x, espec->LineWidths[out_line]);
+  espec->LineWidths[out_line] = ApplyHBlend(espec->surface->pixels + out_line * espec->surface->pitchinpix + espec->DisplayRect.x, espec->LineWidths[out_line], HRes & 0x2);
 
   // Kind of late, but meh. ;p
   assert((espec->DisplayRect.x + espec->LineWidths[out_line]) <= 704);
@@ -3187,7 +3259,6 @@ static NO_INLINE void DrawLine(const uint16 out_line, const uint16 vdp2_line, co
 //
 //
 static MThreading::Thread* RThread = NULL;
-IG::ThreadId RThreadId{};
 
 enum
 {
@@ -3211,53 +3282,84 @@ struct WQ_Entry
  uint32 Arg32;
 };
 
-static IG::RingBuffer<WQ_Entry, {.fixedSize = 0x4000}> WQ;
+// Mirrored so a batch can always be read or written as one contiguous span
+static IG::RingBuffer<WQ_Entry, {.mirrored = true}> WQ;
+
+// Commands are collected here on the emulation thread and published to WQ
+// as a batch, so the render thread's index is only touched once per batch
+static std::array<WQ_Entry, 64> WQBatch;
+static unsigned WQBatchSize;
+
+static void FlushWQ(void)
+{
+ std::span<const WQ_Entry> pending{WQBatch.data(), WQBatchSize};
+
+ while(pending.size())
+ {
+  auto span = WQ.beginWrite(pending.size(), {.blocking = true});
+  std::copy_n(pending.data(), span.size(), span.data());
+  WQ.endWrite(span);
+  pending = pending.subspan(span.size());
+ }
+ WQBatchSize = 0;
+ WQ.notifyWrite();
+}
 
 static INLINE void WWQ(uint16 command, uint32 arg32 = 0, uint16 arg16 = 0)
 {
- WQ.push({command, arg16, arg32}, {.blocking = true, .flushSize = 64});
+ WQBatch[WQBatchSize++] = {command, arg16, arg32};
+
+ if(MDFN_UNLIKELY(WQBatchSize == WQBatch.size()))
+  FlushWQ();
 }
 
 static int RThreadEntry(void* data)
 {
- RThreadId = IG::thisThreadId();
-
- auto nextCommand = []() { return WQ.pop({.blocking = true}); };
- for(WQ_Entry entry = nextCommand(); entry.Command != COMMAND_EXIT; entry = nextCommand())
+ for(bool running = true; running;)
  {
-  WQ_Entry* wqe = &entry;
+  auto span = WQ.beginRead(WQ.capacity(), {.blocking = true});
+  size_t consumed = 0;
 
-  switch(wqe->Command)
+  for(; consumed < span.size() && running; consumed++)
   {
-   case COMMAND_WRITE8:
+   WQ_Entry* wqe = &span[consumed];
+
+   switch(wqe->Command)
+   {
+    case COMMAND_WRITE8:
 	MemW<uint8>(wqe->Arg32, wqe->Arg16);
 	break;
 
-   case COMMAND_WRITE16:
+    case COMMAND_WRITE16:
 	MemW<uint16>(wqe->Arg32, wqe->Arg16);
 	break;
 
-   case COMMAND_DRAW_LINE:
+    case COMMAND_DRAW_LINE:
 	//for(unsigned i = 0; i < 2; i++)
 	DrawLine((uint16)wqe->Arg32, wqe->Arg32 >> 16, wqe->Arg16);
 	//
 	break;
 
-   case COMMAND_RESET:
+    case COMMAND_RESET:
 	Reset(wqe->Arg32);
 	break;
 
-   case COMMAND_SET_LEM:
+    case COMMAND_SET_LEM:
 	UserLayerEnableMask = wqe->Arg32;
 	break;
+
+    case COMMAND_EXIT:
+	running = false;
+	break;
+   }
   }
   //
   //
   //
 
+  WQ.endRead({span.first(consumed), span.idxs});
   WQ.notifyRead();
  }
- WQ.notifyRead();
  return 0;
 }
 
@@ -3267,7 +3369,7 @@ static int RThreadEntry(void* data)
 //
 //
 //
-void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
+void VDP2REND_Init(const bool IsPAL, const uint64 affinity, const unsigned workers)
 {
  PAL = IsPAL;
  VisibleLines = PAL ? 288 : 240;
@@ -3275,10 +3377,30 @@ void VDP2REND_Init(const bool IsPAL, const uint64 affinity)
  UserLayerEnableMask = ~0U;
  Clock28M = false;
  //
+ WQ.setMinCapacity(0x4000);
  WQ.clear();
+ WQBatchSize = 0;
  RThread = MThreading::Thread_Create(RThreadEntry, NULL, "MDFN VDP2 Render");
  if(affinity)
   MThreading::Thread_SetAffinity(RThread, affinity);
+ //
+ FinishCount = 0;
+ FinishExit = false;
+ if(workers)
+ {
+  FinishStartSem = MThreading::Sem_Create();
+  FinishDoneSem = MThreading::Sem_Create();
+
+  for(unsigned i = 0; i < workers; i++)
+  {
+   MThreading::Thread* t = MThreading::Thread_Create(FinishThreadEntry, NULL, "MDFN VDP2 Line Finish");
+
+   if(affinity)
+    MThreading::Thread_SetAffinity(t, affinity);
+
+   FinishThreads.push_back(t);
+  }
+ }
 }
 
 // Needed for ss.correct_aspect == 0
@@ -3343,10 +3465,26 @@ void VDP2REND_Kill(void)
  if(RThread != NULL)
  {
   WWQ(COMMAND_EXIT);
-  WQ.notifyWrite();
+  FlushWQ();
   MThreading::Thread_Wait(RThread, NULL);
   RThread = NULL;
-  RThreadId = {};
+ }
+
+ if(FinishThreads.size())
+ {
+  FinishExit = true;
+
+  for(size_t i = 0; i < FinishThreads.size(); i++)
+   MThreading::Sem_Post(FinishStartSem);
+
+  for(MThreading::Thread* t : FinishThreads)
+   MThreading::Thread_Wait(t, NULL);
+
+  FinishThreads.clear();
+  MThreading::Sem_Destroy(FinishStartSem);
+  MThreading::Sem_Destroy(FinishDoneSem);
+  FinishStartSem = NULL;
+  FinishDoneSem = NULL;
  }
 }
 
@@ -3374,8 +3512,24 @@ void VDP2REND_StartFrame(EmulateSpecStruct* espec_arg, const bool clock28m, cons
 
 void VDP2REND_EndFrame(void)
 {
+ FlushWQ();
  WQ.waitForSize(0);
 
+ if(FinishCount)
+ {
+  FinishNext.store(0, std::memory_order_relaxed);
+
+  for(size_t i = 0; i < FinishThreads.size(); i++)
+   MThreading::Sem_Post(FinishStartSem);
+
+  FinishLines();
+
+  for(size_t i = 0; i < FinishThreads.size(); i++)
+   MThreading::Sem_Wait(FinishDoneSem);
+
+  FinishCount = 0;
+ }
+
  if(NextOutLine < VisibleLines)
  {
   //printf("OutLineCounter(%d) < VisibleLines(%d)\n", OutLineCounter, VisibleLines);
@@ -3419,7 +3573,7 @@ void VDP2REND_DrawLine(const int vdp2_line, const uint32 crt_line, const bool fi
   WWQ(COMMAND_DRAW_LINE, ((uint16)vdp2_line << 16) | out_line, field);
   //
   //
-  WQ.notifyWrite();
+  FlushWQ();
 
   NextOutLine = crt_line + 1;
  }
@@ -3453,6 +3607,7 @@ void VDP2REND_Write16_DB(uint32 A, uint16 DB)
 
 void VDP2REND_StateAction(StateMem* sm, const unsigned load, const bool data_only, uint16 (&rr)[0x100], uint16 (&cr)[2048], uint16 (&vr)[262144])
 {
+ FlushWQ();
  WQ.waitForSize(0);
  //
  //
@@ -14,6 +14,7 @@
 #include <cheats.h>
 #ifndef SNES9X_VERSION_1_4
 #include <apu/bapu/snes/snes.hpp>
+#include <msu1.h>
 #else
 #include <soundux.h>
 #endif
@@ -382,6 +383,10 @@ void Snes9xSystem::runFrame(EmuSystemTaskContext taskCtx, EmuVideo *video, EmuAu
 		}, (void*)audio);
 	#endif
 	S9xMainLoop();
+	#ifndef SNES9X_VERSION_1_4
+	if(Settings.MSU1)
+		S9xMSU1FinishFrame();
+	#endif
 	// video rendered in S9xDeinitUpdate
 	#ifdef SNES9X_VERSION_1_4
 	auto samples = updateAudioFramesPerVideoFrame() * 2;
@@ -14,9 +14,149 @@
 #include <fstream>
 #include <sys/stat.h>
 #include <main/wrappers.h>
+#include <imagine/io/FileIO.hh>
+#include <imagine/base/ApplicationContext.hh>
+#include <imagine/thread/ThreadRegistry.hh>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace EmuEx
+{
+IG::ApplicationContext gAppContext();
+}
+
+// Read-only MSU-1 file, memory mapped when possible so data port and sample reads
+// are plain memory accesses with the kernel handling readahead
+struct MSU1File
+{
+	IG::FileIO io;
+	std::span<uint8_t> data;
+
+	MSU1File() = default;
+	MSU1File(IG::FileIO io_): io{std::move(io_)}, data{io.map()} {}
+	explicit operator bool() const { return (bool)io; }
+	size_t size() { return data.size() ? data.size() : io.size(); }
+
+	size_t read(void *buff, size_t bytes, size_t offset)
+	{
+		if (data.size())
+		{
+			if (offset >= data.size())
+				return 0;
+			bytes = std::min(bytes, data.size() - offset);
+			memcpy(buff, &data[offset], bytes);
+			return bytes;
+		}
+		auto bytesRead = io.read(buff, bytes, offset);
+		return bytesRead > 0 ? bytesRead : 0;
+	}
+
+	void prefetch(size_t offset, size_t bytes)
+	{
+		if (offset < size())
+			io.advise(offset, bytes, IG::IOAdvice::WillNeed);
+	}
+};
 
-STREAM dataStream = NULL;
-STREAM audioStream = NULL;
+static MSU1File MSU1OpenMappedFile(const std::string &path, IG::IOAccessHint hint)
+{
+	return {EmuEx::gAppContext().openFileUri(path, {.test = true, .accessHint = hint})};
+}
+
+// Opens audio tracks on a helper thread so a track change doesn't stall emulation on slow storage,
+// games poll AudioBusy until the track is ready as the MSU-1 spec requires. The open is always
+// finished at the end of the frame it started in so emulation doesn't depend on storage timing
+class MSU1TrackLoader
+{
+public:
+	static constexpr size_t prefetchBytes = 0x40000;
+
+	~MSU1TrackLoader() { stop(); }
+
+	void request(std::string path)
+	{
+		{
+			std::lock_guard lock{mutex};
+			requestPath = std::move(path);
+			requestId++;
+			result.reset();
+		}
+		if (!thread.joinable())
+			thread = std::thread{[this]{ run(); }};
+		cond.notify_all();
+	}
+
+	// waits for the newest requested track to open, returns nothing if the request was cancelled
+	std::optional<MSU1File> waitResult()
+	{
+		std::unique_lock lock{mutex};
+		cond.wait(lock, [&]{ return completedId == requestId; });
+		return std::exchange(result, {});
+	}
+
+	void cancel()
+	{
+		std::lock_guard lock{mutex};
+		completedId = ++requestId;
+		requestPath.clear();
+		result.reset();
+	}
+
+	void stop()
+	{
+		if (!thread.joinable())
+			return;
+		{
+			std::lock_guard lock{mutex};
+			quit = true;
+		}
+		cond.notify_all();
+		thread.join();
+		quit = false;
+		cancel();
+	}
+
+private:
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable cond;
+	std::string requestPath;
+	std::optional<MSU1File> result;
+	uint32 requestId{};
+	uint32 completedId{};
+	bool quit{};
+
+	void run()
+	{
+		auto registration = IG::helperThreads().registerThisThread("MSU-1 Track Loader", IG::ThreadRole::background);
+		std::unique_lock lock{mutex};
+		for (;;)
+		{
+			cond.wait(lock, [&]{ return quit || completedId != requestId; });
+			if (quit)
+				return;
+			auto id = requestId;
+			auto path = std::exchange(requestPath, {});
+			lock.unlock();
+			auto file = MSU1OpenMappedFile(path, IG::IOAccessHint::Sequential);
+			if (file)
+				file.prefetch(0, prefetchBytes);
+			lock.lock();
+			if (id != requestId) // superseded by a newer track change or cancelled
+				continue;
+			result = std::move(file);
+			completedId = id;
+			cond.notify_all();
+		}
+	}
+};
+
+static MSU1File dataFile;
+static MSU1File audioFile;
+static MSU1TrackLoader trackLoader;
 uint32 audioLoopPos;
 size_t partial_frames;
 
@@ -100,66 +240,87 @@ STREAM S9xMSU1OpenFile(const char *msu_ext, bool skip_unpacked)
 
 static void AudioClose()
 {
-	if (audioStream)
-	{
-		CLOSE_STREAM(audioStream);
-		audioStream = NULL;
-	}
+	audioFile = {};
 }
 
-static bool AudioOpen()
+static std::string AudioTrackPath()
+{
+	std::string extension = "-" + std::to_string(MSU1.MSU1_CURRENT_TRACK) + ".pcm";
+	return S9xGetFilename(extension.c_str(), ROMFILENAME_DIR);
+}
+
+// Takes ownership of an opened track and parses its header
+static bool AudioAttach(MSU1File file)
 {
 	MSU1.MSU1_STATUS |= AudioError;
 
 	AudioClose();
 
-	std::string extension = "-" + std::to_string(MSU1.MSU1_CURRENT_TRACK) + ".pcm";
+	alignas(4) uint8 header[8];
+	if (!file || file.read(header, 8, 0) != 8 || memcmp(header, "MSU1", 4) != 0)
+		return false;
+
+	audioLoopPos = GET_LE32(&header[4]);
+	audioLoopPos <<= 2;
+	audioLoopPos += 8;
 
-    audioStream = S9xMSU1OpenFile(extension.c_str());
-	if (audioStream)
+	MSU1.MSU1_AUDIO_POS = 8;
+
+	audioFile = std::move(file);
+	MSU1.MSU1_STATUS &= ~AudioError;
+	return true;
+}
+
+static bool AudioOpen()
+{
+	return AudioAttach(MSU1OpenMappedFile(AudioTrackPath(), IG::IOAccessHint::Sequential));
+}
+
+// Completes a track change started by a write to port 5
+static void AudioOpenFinish(MSU1File file)
+{
+	MSU1.MSU1_STATUS &= ~AudioBusy;
+
+	if (AudioAttach(std::move(file)))
 	{
-		if (GETC_STREAM(audioStream) != 'M')
-			return false;
-		if (GETC_STREAM(audioStream) != 'S')
-			return false;
-		if (GETC_STREAM(audioStream) != 'U')
-			return false;
-		if (GETC_STREAM(audioStream) != '1')
-			return false;
-
-        READ_STREAM((char *)&audioLoopPos, 4, audioStream);
-		audioLoopPos = GET_LE32(&audioLoopPos);
-		audioLoopPos <<= 2;
-		audioLoopPos += 8;
-
-        MSU1.MSU1_AUDIO_POS = 8;
-
-		MSU1.MSU1_STATUS &= ~AudioError;
-		return true;
+		if (MSU1.MSU1_CURRENT_TRACK == MSU1.MSU1_RESUME_TRACK)
+		{
+			MSU1.MSU1_AUDIO_POS = MSU1.MSU1_RESUME_POS;
+			MSU1.MSU1_RESUME_POS = 0;
+			MSU1.MSU1_RESUME_TRACK = ~0;
+		}
+		else
+		{
+			MSU1.MSU1_AUDIO_POS = 8;
+		}
+
+		audioFile.prefetch(MSU1.MSU1_AUDIO_POS, MSU1TrackLoader::prefetchBytes);
 	}
+}
 
-	return false;
+static void AudioWaitOpen()
+{
+	if (!(MSU1.MSU1_STATUS & AudioBusy))
+		return;
+	if (auto file = trackLoader.waitResult())
+		AudioOpenFinish(std::move(*file));
 }
 
 static void DataClose()
 {
-	if (dataStream)
-	{
-		CLOSE_STREAM(dataStream);
-		dataStream = NULL;
-	}
+	dataFile = {};
 }
 
 static bool DataOpen()
 {
 	DataClose();
 
-    dataStream = S9xMSU1OpenFile(".msu");
+	dataFile = MSU1OpenMappedFile(S9xGetFilename(".msu", ROMFILENAME_DIR), IG::IOAccessHint::Random);
 
-	if(!dataStream)
-		dataStream = S9xMSU1OpenFile("msu1.rom");
+	if (!dataFile)
+		dataFile = MSU1OpenMappedFile(S9xGetFilename("msu1.rom", ROMFILENAME_DIR), IG::IOAccessHint::Random);
 
-	return dataStream != NULL;
+	return (bool)dataFile;
 }
 
 void S9xResetMSU(void)
@@ -180,6 +341,8 @@ void S9xResetMSU(void)
 
 	partial_frames = 0;
 
+	trackLoader.cancel();
+
 	DataClose();
 
 	AudioClose();
@@ -195,6 +358,7 @@ void S9xMSU1Init(void)
 
 void S9xMSU1DeInit(void)
 {
+	trackLoader.stop();
 	DataClose();
 	AudioClose();
 }
@@ -226,30 +390,35 @@ bool S9xMSU1ROMExists(void)
     return false;
 }
 
+void S9xMSU1FinishFrame(void)
+{
+	AudioWaitOpen();
+}
+
 void S9xMSU1Generate(size_t sample_count)
 {
 	partial_frames += 4410 * (sample_count / 2);
 
 	while (partial_frames >= 3204)
 	{
-		if (MSU1.MSU1_STATUS & AudioPlaying && audioStream)
+		if (MSU1.MSU1_STATUS & AudioPlaying && audioFile)
 		{
-			int32 sample;
-			int16* left = (int16*)&sample;
-			int16* right = left + 1;
+			alignas(4) uint8 sample[4];
 
-			int bytes_read = READ_STREAM((char *)&sample, 4, audioStream);
-			if (bytes_read == 4)
+			if (audioFile.read(sample, 4, MSU1.MSU1_AUDIO_POS) == 4)
 			{
-				*left = ((int32)(int16)GET_LE16(left) * MSU1.MSU1_VOLUME / 255);
-				*right = ((int32)(int16)GET_LE16(right) * MSU1.MSU1_VOLUME / 255);
+				int16 left = ((int32)(int16)GET_LE16(&sample[0]) * MSU1.MSU1_VOLUME / 255);
+				int16 right = ((int32)(int16)GET_LE16(&sample[2]) * MSU1.MSU1_VOLUME / 255);
 
-				msu_resampler->push_sample(*left, *right);
+				msu_resampler->push_sample(left, right);
 				MSU1.MSU1_AUDIO_POS += 4;
 				partial_frames -= 3204;
+
+				// keep the kernel reading ahead of playback so sample reads don't wait on storage
+				if ((MSU1.MSU1_AUDIO_POS & 0xFFFF) == 0)
+					audioFile.prefetch(MSU1.MSU1_AUDIO_POS, MSU1TrackLoader::prefetchBytes);
 			}
 			else
-			if (bytes_read >= 0)
 			{
 				if (MSU1.MSU1_STATUS & AudioRepeating)
 				{
@@ -261,18 +430,18 @@ void S9xMSU1Generate(size_t sample_count)
 					{
 						MSU1.MSU1_AUDIO_POS = 8;
 					}
-					REVERT_STREAM(audioStream, MSU1.MSU1_AUDIO_POS, 0);
+
+					if (MSU1.MSU1_AUDIO_POS + 4 > audioFile.size()) // no samples to loop over
+						MSU1.MSU1_STATUS &= ~(AudioPlaying | AudioRepeating);
+					else
+						audioFile.prefetch(MSU1.MSU1_AUDIO_POS, MSU1TrackLoader::prefetchBytes);
 				}
 				else
 				{
 					MSU1.MSU1_STATUS &= ~(AudioPlaying | AudioRepeating);
-					REVERT_STREAM(audioStream, 8, 0);
+					MSU1.MSU1_AUDIO_POS = 8;
 				}
 			}
-			else
-			{
-				MSU1.MSU1_STATUS &= ~(AudioPlaying | AudioRepeating);
-			}
 		}
 		else
 		{
@@ -294,10 +463,16 @@ uint8 S9xMSU1ReadPort(uint8 port)
     {
         if (MSU1.MSU1_STATUS & DataBusy)
             return 0;
-        if (!dataStream)
+        if (!dataFile)
             return 0;
-        int data = GETC_STREAM(dataStream);
-        if (data >= 0)
+        if (dataFile.data.size())
+        {
+            if (MSU1.MSU1_DATA_POS >= dataFile.data.size())
+                return 0;
+            return dataFile.data[MSU1.MSU1_DATA_POS++];
+        }
+        uint8 data;
+        if (dataFile.read(&data, 1, MSU1.MSU1_DATA_POS) == 1)
         {
             MSU1.MSU1_DATA_POS++;
             return data;
@@ -342,10 +517,6 @@ void S9xMSU1WritePort(uint8 port, uint8 byte)
 		MSU1.MSU1_DATA_SEEK &= 0x00FFFFFF;
 		MSU1.MSU1_DATA_SEEK |= byte << 24;
 		MSU1.MSU1_DATA_POS = MSU1.MSU1_DATA_SEEK;
-        if (dataStream)
-        {
-            REVERT_STREAM(dataStream, MSU1.MSU1_DATA_POS, 0);
-        }
 		break;
 	case 4:
 		MSU1.MSU1_TRACK_SEEK &= 0xFF00;
@@ -356,29 +527,19 @@ void S9xMSU1WritePort(uint8 port, uint8 byte)
 		MSU1.MSU1_TRACK_SEEK |= (byte << 8);
 		MSU1.MSU1_CURRENT_TRACK = MSU1.MSU1_TRACK_SEEK;
 
-		MSU1.MSU1_STATUS &= ~AudioPlaying;
-		MSU1.MSU1_STATUS &= ~AudioRepeating;
-
-		if (AudioOpen())
-		{
-			if (MSU1.MSU1_CURRENT_TRACK == MSU1.MSU1_RESUME_TRACK)
-			{
-				MSU1.MSU1_AUDIO_POS = MSU1.MSU1_RESUME_POS;
-				MSU1.MSU1_RESUME_POS = 0;
-				MSU1.MSU1_RESUME_TRACK = ~0;
-			}
-			else
-			{
-				MSU1.MSU1_AUDIO_POS = 8;
-			}
+		MSU1.MSU1_STATUS &= ~(AudioPlaying | AudioRepeating | AudioError);
+		MSU1.MSU1_STATUS |= AudioBusy;
 
-            REVERT_STREAM(audioStream, MSU1.MSU1_AUDIO_POS, 0);
-		}
+		AudioClose();
+		trackLoader.request(AudioTrackPath());
 		break;
 	case 6:
 		MSU1.MSU1_VOLUME = byte;
 		break;
 	case 7:
+		// games should wait for AudioBusy to clear before playing, finish the open here for any that don't
+		AudioWaitOpen();
+
 		if (MSU1.MSU1_STATUS & (AudioBusy | AudioError))
 			break;
 
@@ -405,25 +566,22 @@ void S9xMSU1SetOutput(Resampler *resampler)
 
 void S9xMSU1PostLoadState(void)
 {
-	if (DataOpen())
+	trackLoader.cancel();
+
+	DataOpen();
+
+	if (MSU1.MSU1_STATUS & AudioBusy)
 	{
-        REVERT_STREAM(dataStream, MSU1.MSU1_DATA_POS, 0);
+		AudioOpenFinish(MSU1OpenMappedFile(AudioTrackPath(), IG::IOAccessHint::Sequential));
 	}
-
-	if (MSU1.MSU1_STATUS & AudioPlaying)
+	else if (MSU1.MSU1_STATUS & AudioPlaying)
 	{
 		uint32 savedPosition = MSU1.MSU1_AUDIO_POS;
 
 		if (AudioOpen())
 		{
-            REVERT_STREAM(audioStream, 4, 0);
-            READ_STREAM((char *)&audioLoopPos, 4, audioStream);
-			audioLoopPos = GET_LE32(&audioLoopPos);
-			audioLoopPos <<= 2;
-			audioLoopPos += 8;
-
 			MSU1.MSU1_AUDIO_POS = savedPosition;
-            REVERT_STREAM(audioStream, MSU1.MSU1_AUDIO_POS, 0);
+			audioFile.prefetch(MSU1.MSU1_AUDIO_POS, MSU1TrackLoader::prefetchBytes);
 		}
 		else
 		{
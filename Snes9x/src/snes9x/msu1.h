@@ -48,6 +48,7 @@ bool S9xMSU1ROMExists(void);
 STREAM S9xMSU1OpenFile(const char *msu_ext, bool skip_unpacked = FALSE);
 void S9xMSU1Init(void);
 void S9xMSU1Generate(size_t sample_count);
+void S9xMSU1FinishFrame(void);
 uint8 S9xMSU1ReadPort(uint8 port);
 void S9xMSU1WritePort(uint8 port, uint8 byte);
 size_t S9xMSU1Samples(void);
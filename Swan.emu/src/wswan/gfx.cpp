@@ -648,6 +648,8 @@ static void wsScanline(MDFN_Surface* surface)
 	uint8		b_bg[256];
 	uint8		b_bg_pal[256];
 
+	wsUpdateTiles(); /*decode tiles written since the last line*/
+
 	if(!wsVMode)
 		memset(b_bg, wsColors[BGColor&0xF]&0xF, 256);
 	else
@@ -1057,6 +1059,8 @@ static void DoGfxDecode(void)
  uint32 tile_limit;
  uint32 zero_color = GfxDecode_Buf->MakeColor(0, 0, 0, 0);
 
+ wsUpdateTiles();
+
  if(wsVMode && GfxDecode_Layer != 2) // Sprites can't use the extra tile bank in WSC mode
   tile_limit = 0x400;
  else
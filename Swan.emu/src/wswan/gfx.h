@@ -16,10 +16,19 @@ MDFN_HIDE extern uint8	wsTCacheFlipped2[512*64];  	  //tiles cache (H flip)
 MDFN_HIDE extern uint8	wsTCacheUpdate2[512];	  //tiles cache flags
 MDFN_HIDE extern int	wsVMode;			  //Video Mode	
 
-void wsMakeTiles(void);
-void wsGetTile(uint32,uint32,int,int,int);
+void wsUpdateTiles(void);
 void wsSetVideo(int, bool);
 
+// Copies a row of a tile decoded by wsUpdateTiles() into wsTileRow
+static INLINE void wsGetTile(uint32 number,uint32 line,int flipv,int fliph,int bank)
+{
+ const bool useBank2 = bank && (wsVMode & 0x07);
+ const uint8 *cache = fliph ? (useBank2 ? wsTCacheFlipped2 : wsTCacheFlipped) : (useBank2 ? wsTCache2 : wsTCache);
+ if(flipv)
+  line=7-line;
+ memcpy(&wsTileRow[0],&cache[(number<<6)|(line<<3)],8);
+}
+
 MDFN_HIDE extern uint32	dx_r,dx_g,dx_b,dx_sr,dx_sg,dx_sb;
 MDFN_HIDE extern uint32	dx_bits,dx_pitch,cmov,dx_linewidth_blit,dx_buffer_line;
 
@@ -385,8 +385,6 @@ static void Load(GameFile* gf)
 
   RTC_Init();
 
-  wsMakeTiles();
-
   Reset();
  }
  catch(...)
@@ -26,7 +26,6 @@ namespace MDFN_IEN_WSWAN
 {
 
 
-static uint8	tiles[256][256][2][8];
 uint8	wsTCache[512*64];			
 uint8	wsTCache2[512*64];			
 uint8	wsTCacheFlipped[512*64];
@@ -36,27 +35,41 @@ uint8	wsTCacheUpdate2[512];
 uint8	wsTileRow[8];
 int	wsVMode;				
 
+// Tiles invalidated since the last wsUpdateTiles(), as (bank << 9) | number,
+// a tile is listed exactly when its update flag is false
+static uint16 DirtyTiles[1024];
+static uint32 DirtyTileCount;
+
+static INLINE void MarkTileDirty(uint8 *update, uint32 number, uint32 bank)
+{
+ if(update[number])
+ {
+  update[number] = false;
+  DirtyTiles[DirtyTileCount++] = (bank << 9) | number;
+ }
+}
+
 void WSWan_TCacheInvalidByAddr(uint32 ws_offset)
 {
   if(wsVMode  && (ws_offset>=0x4000)&&(ws_offset<0x8000))
   {
-   wsTCacheUpdate[(ws_offset-0x4000)>>5]=false; /*invalidate tile*/
+   MarkTileDirty(wsTCacheUpdate, (ws_offset-0x4000)>>5, 0); /*invalidate tile*/
    return;
   }
   else if((ws_offset>=0x2000)&&(ws_offset<0x4000))
   {
-   wsTCacheUpdate[(ws_offset-0x2000)>>4]=false; /*invalidate tile*/
+   MarkTileDirty(wsTCacheUpdate, (ws_offset-0x2000)>>4, 0); /*invalidate tile*/
    return;
   }
 
   if(wsVMode  && (ws_offset>=0x8000)&&(ws_offset<0xc000))
   {
-   wsTCacheUpdate2[(ws_offset-0x8000)>>5]=false; /*invalidate tile*/
+   MarkTileDirty(wsTCacheUpdate2, (ws_offset-0x8000)>>5, 1); /*invalidate tile*/
    return;
   }
   else if((ws_offset>=0x4000)&&(ws_offset<0x6000))
   {
-   wsTCacheUpdate2[(ws_offset-0x4000)>>4]=false; /*invalidate tile*/
+   MarkTileDirty(wsTCacheUpdate2, (ws_offset-0x4000)>>4, 1); /*invalidate tile*/
    return;
   }
 }
@@ -68,241 +81,84 @@ void wsSetVideo(int number,bool force)
   wsVMode=number;
   memset(wsTCacheUpdate,0,512);
   memset(wsTCacheUpdate2,0,512);
+  for(uint32 i = 0; i < 1024; i++)
+   DirtyTiles[i] = i;
+  DirtyTileCount = 1024;
  }
 }
 
-void wsMakeTiles(void)
+// Expands a bitplane byte to one byte per pixel holding 0 or 1, leftmost (MSB) pixel in the lowest byte
+static INLINE uint64 PlanePixels(uint8 plane)
 {
- int	x,y,b0,b1,b2,b3,b4,b5,b6,b7;
- for(x=0;x<256;x++)
-	 for(y=0;y<256;y++)
-	 {
-		b0=(x&128)>>7;b1=(x&64)>>6;b2=(x&32)>>5;b3=(x&16)>>4;b4=(x&8)>>3;b5=(x&4)>>2;b6=(x&2)>>1;b7=(x&1);
-		b0|=(y&128)>>6;b1|=(y&64)>>5;b2|=(y&32)>>4;b3|=(y&16)>>3;b4|=(y&8)>>2;b5|=(y&4)>>1;b6|=(y&2);b7|=(y&1)<<1;
-		tiles[x][y][0][0]=b0;
-		tiles[x][y][0][1]=b1;
-		tiles[x][y][0][2]=b2;
-		tiles[x][y][0][3]=b3;
-		tiles[x][y][0][4]=b4;
-		tiles[x][y][0][5]=b5;
-		tiles[x][y][0][6]=b6;
-		tiles[x][y][0][7]=b7;
-		tiles[x][y][1][0]=b7;
-		tiles[x][y][1][1]=b6;
-		tiles[x][y][1][2]=b5;
-		tiles[x][y][1][3]=b4;
-		tiles[x][y][1][4]=b3;
-		tiles[x][y][1][5]=b2;
-		tiles[x][y][1][6]=b1;
-		tiles[x][y][1][7]=b0;
-	 }
+ uint64 x = (plane * 0x0101010101010101ULL) & 0x0102040810204080ULL;
+ return ((x + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
 }
 
-void wsGetTile(uint32 number,uint32 line,int flipv,int fliph,int bank)
+// Same as PlanePixels() with the pixel order reversed
+static INLINE uint64 PlanePixelsFlipped(uint8 plane)
 {
- uint32		t_adr,t_index,i;
- uint8		byte0,byte1,byte2,byte3;
+ uint64 x = (plane * 0x0101010101010101ULL) & 0x8040201008040201ULL;
+ return ((x + 0x7F7F7F7F7F7F7F7FULL) >> 7) & 0x0101010101010101ULL;
+}
 
- if((!bank)||(!(wsVMode &0x07)))
- {
+static void DecodeTile(uint32 number, uint32 bank)
+{
+ uint8 *cache = bank ? wsTCache2 : wsTCache;
+ uint8 *cacheFlipped = bank ? wsTCacheFlipped2 : wsTCacheFlipped;
+ uint32 t_index = number << 6;
 
-#ifdef TCACHE_OFF
- wsTCacheUpdate[number]=false;
-#endif
-	 
-  if(!wsTCacheUpdate[number])
+ switch(wsVMode)
+ {
+  case 7: // 4bpp packed
   {
-   wsTCacheUpdate[number]=true;
-   switch(wsVMode)
+   const uint8 *src = &wsRAM[(bank ? 0x8000 : 0x4000) + (number << 5)];
+   for(uint32 i = 0; i < 8; i++, src += 4, t_index += 8)
    {
-	case 7:
-	 t_adr=0x4000+(number<<5);
-	 t_index=number<<6;
-	 for(i=0;i<8;i++)
-	 {
-	  byte0=wsRAM[t_adr++];
-	  byte1=wsRAM[t_adr++];
-	  byte2=wsRAM[t_adr++];
-	  byte3=wsRAM[t_adr++];
-	  wsTCache[t_index]=byte0>>4;
-	  wsTCacheFlipped[t_index++]=byte3&15;
-	  wsTCache[t_index]=byte0&15;
-	  wsTCacheFlipped[t_index++]=byte3>>4;
-	  wsTCache[t_index]=byte1>>4;
-	  wsTCacheFlipped[t_index++]=byte2&15;
-      wsTCache[t_index]=byte1&15;
-	  wsTCacheFlipped[t_index++]=byte2>>4;
-	  wsTCache[t_index]=byte2>>4;
-	  wsTCacheFlipped[t_index++]=byte1&15;
-	  wsTCache[t_index]=byte2&15;
-	  wsTCacheFlipped[t_index++]=byte1>>4;
-	  wsTCache[t_index]=byte3>>4;
-	  wsTCacheFlipped[t_index++]=byte0&15;
-	  wsTCache[t_index]=byte3&15;
-	  wsTCacheFlipped[t_index++]=byte0>>4;
-	 }
-	break;
-
-	case 6:
-     t_adr=0x4000+(number<<5);
-	 t_index=number<<6;
-	 for(i=0;i<8;i++)
-	 {
-	  byte0=wsRAM[t_adr++];
-	  byte1=wsRAM[t_adr++];
-	  byte2=wsRAM[t_adr++];
-	  byte3=wsRAM[t_adr++];
-	  wsTCache[t_index]=((byte0>>7)&1)|(((byte1>>7)&1)<<1)|(((byte2>>7)&1)<<2)|(((byte3>>7)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0)&1)|(((byte1)&1)<<1)|(((byte2)&1)<<2)|(((byte3)&1)<<3);
-	  wsTCache[t_index]=((byte0>>6)&1)|(((byte1>>6)&1)<<1)|(((byte2>>6)&1)<<2)|(((byte3>>6)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>1)&1)|(((byte1>>1)&1)<<1)|(((byte2>>1)&1)<<2)|(((byte3>>1)&1)<<3);
-	  wsTCache[t_index]=((byte0>>5)&1)|(((byte1>>5)&1)<<1)|(((byte2>>5)&1)<<2)|(((byte3>>5)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>2)&1)|(((byte1>>2)&1)<<1)|(((byte2>>2)&1)<<2)|(((byte3>>2)&1)<<3);
-	  wsTCache[t_index]=((byte0>>4)&1)|(((byte1>>4)&1)<<1)|(((byte2>>4)&1)<<2)|(((byte3>>4)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>3)&1)|(((byte1>>3)&1)<<1)|(((byte2>>3)&1)<<2)|(((byte3>>3)&1)<<3);
-	  wsTCache[t_index]=((byte0>>3)&1)|(((byte1>>3)&1)<<1)|(((byte2>>3)&1)<<2)|(((byte3>>3)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>4)&1)|(((byte1>>4)&1)<<1)|(((byte2>>4)&1)<<2)|(((byte3>>4)&1)<<3);
-	  wsTCache[t_index]=((byte0>>2)&1)|(((byte1>>2)&1)<<1)|(((byte2>>2)&1)<<2)|(((byte3>>2)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>5)&1)|(((byte1>>5)&1)<<1)|(((byte2>>5)&1)<<2)|(((byte3>>5)&1)<<3);
-	  wsTCache[t_index]=((byte0>>1)&1)|(((byte1>>1)&1)<<1)|(((byte2>>1)&1)<<2)|(((byte3>>1)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>6)&1)|(((byte1>>6)&1)<<1)|(((byte2>>6)&1)<<2)|(((byte3>>6)&1)<<3);
-	  wsTCache[t_index]=((byte0)&1)|(((byte1)&1)<<1)|(((byte2)&1)<<2)|(((byte3)&1)<<3);
-	  wsTCacheFlipped[t_index++]=((byte0>>7)&1)|(((byte1>>7)&1)<<1)|(((byte2>>7)&1)<<2)|(((byte3>>7)&1)<<3);
-	 }
-    break;
+    for(uint32 p = 0; p < 4; p++)
+    {
+     cache[t_index + p*2] = src[p] >> 4;
+     cache[t_index + p*2 + 1] = src[p] & 0xF;
+     cacheFlipped[t_index + 7 - p*2] = src[p] >> 4;
+     cacheFlipped[t_index + 6 - p*2] = src[p] & 0xF;
+    }
+   }
+   break;
+  }
 
-	default:
-	 t_adr=0x2000+(number<<4);
-	 t_index=number<<6;
-	 for(i=0;i<8;i++)
-	 {
-	  byte0=wsRAM[t_adr++];
-	  byte1=wsRAM[t_adr++];
-	  wsTCache[t_index]=tiles[byte0][byte1][0][0];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][0];
-          wsTCache[t_index]=tiles[byte0][byte1][0][1];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][1];
-          wsTCache[t_index]=tiles[byte0][byte1][0][2];
- 	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][2];
-          wsTCache[t_index]=tiles[byte0][byte1][0][3];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][3];
-          wsTCache[t_index]=tiles[byte0][byte1][0][4];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][4];
-          wsTCache[t_index]=tiles[byte0][byte1][0][5];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][5];
-          wsTCache[t_index]=tiles[byte0][byte1][0][6];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][6];
-          wsTCache[t_index]=tiles[byte0][byte1][0][7];
-	  wsTCacheFlipped[t_index++]=tiles[byte0][byte1][1][7];
-	 }
-	}
+  case 6: // 4bpp planar
+  {
+   const uint8 *src = &wsRAM[(bank ? 0x8000 : 0x4000) + (number << 5)];
+   for(uint32 i = 0; i < 8; i++, src += 4, t_index += 8)
+   {
+    MDFN_en64lsb(&cache[t_index], PlanePixels(src[0]) | (PlanePixels(src[1]) << 1) | (PlanePixels(src[2]) << 2) | (PlanePixels(src[3]) << 3));
+    MDFN_en64lsb(&cacheFlipped[t_index], PlanePixelsFlipped(src[0]) | (PlanePixelsFlipped(src[1]) << 1) | (PlanePixelsFlipped(src[2]) << 2) | (PlanePixelsFlipped(src[3]) << 3));
+   }
+   break;
   }
-  if(flipv)
-   line=7-line;
-  if(fliph)
-   memcpy(&wsTileRow[0],&wsTCacheFlipped[(number<<6)|(line<<3)],8);
-  else
-   memcpy(&wsTileRow[0],&wsTCache[(number<<6)|(line<<3)],8);
- }
- else
- {
 
-#ifdef TCACHE_OFF
- wsTCacheUpdate2[number]=false;
-#endif
-	 
-  if(!wsTCacheUpdate2[number])
+  default: // 2bpp planar
   {
-   wsTCacheUpdate2[number]=true;
-   switch(wsVMode)
+   const uint8 *src = &wsRAM[(bank ? 0x4000 : 0x2000) + (number << 4)];
+   for(uint32 i = 0; i < 8; i++, src += 2, t_index += 8)
    {
-	case 7:
-     t_adr=0x8000+(number<<5);
-	 t_index=number<<6;
-	 for(i=0;i<8;i++)
-	 {
-	  byte0=wsRAM[t_adr++];
-	  byte1=wsRAM[t_adr++];
-	  byte2=wsRAM[t_adr++];
-	  byte3=wsRAM[t_adr++];
-	  wsTCache2[t_index]=byte0>>4;
-	  wsTCacheFlipped2[t_index++]=byte3&15;
-	  wsTCache2[t_index]=byte0&15;
-	  wsTCacheFlipped2[t_index++]=byte3>>4;
-	  wsTCache2[t_index]=byte1>>4;
-	  wsTCacheFlipped2[t_index++]=byte2&15;
-	  wsTCache2[t_index]=byte1&15;
-	  wsTCacheFlipped2[t_index++]=byte2>>4;
-	  wsTCache2[t_index]=byte2>>4;
-	  wsTCacheFlipped2[t_index++]=byte1&15;
-	  wsTCache2[t_index]=byte2&15;
-	  wsTCacheFlipped2[t_index++]=byte1>>4;
-	  wsTCache2[t_index]=byte3>>4;
-	  wsTCacheFlipped2[t_index++]=byte0&15;
-	  wsTCache2[t_index]=byte3&15;
-	  wsTCacheFlipped2[t_index++]=byte0>>4;
-	 }
-	break;
-    case 6:
-	 t_adr=0x8000+(number<<5);
-	 t_index=number<<6;
-	 for(i=0;i<8;i++)
-	 {
-	  byte0=wsRAM[t_adr++];
-	  byte1=wsRAM[t_adr++];
-	  byte2=wsRAM[t_adr++];
-	  byte3=wsRAM[t_adr++];
-	  wsTCache2[t_index]=((byte0>>7)&1)|(((byte1>>7)&1)<<1)|(((byte2>>7)&1)<<2)|(((byte3>>7)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0)&1)|(((byte1)&1)<<1)|(((byte2)&1)<<2)|(((byte3)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>6)&1)|(((byte1>>6)&1)<<1)|(((byte2>>6)&1)<<2)|(((byte3>>6)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>1)&1)|(((byte1>>1)&1)<<1)|(((byte2>>1)&1)<<2)|(((byte3>>1)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>5)&1)|(((byte1>>5)&1)<<1)|(((byte2>>5)&1)<<2)|(((byte3>>5)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>2)&1)|(((byte1>>2)&1)<<1)|(((byte2>>2)&1)<<2)|(((byte3>>2)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>4)&1)|(((byte1>>4)&1)<<1)|(((byte2>>4)&1)<<2)|(((byte3>>4)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>3)&1)|(((byte1>>3)&1)<<1)|(((byte2>>3)&1)<<2)|(((byte3>>3)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>3)&1)|(((byte1>>3)&1)<<1)|(((byte2>>3)&1)<<2)|(((byte3>>3)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>4)&1)|(((byte1>>4)&1)<<1)|(((byte2>>4)&1)<<2)|(((byte3>>4)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>2)&1)|(((byte1>>2)&1)<<1)|(((byte2>>2)&1)<<2)|(((byte3>>2)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>5)&1)|(((byte1>>5)&1)<<1)|(((byte2>>5)&1)<<2)|(((byte3>>5)&1)<<3);
-	  wsTCache2[t_index]=((byte0>>1)&1)|(((byte1>>1)&1)<<1)|(((byte2>>1)&1)<<2)|(((byte3>>1)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>6)&1)|(((byte1>>6)&1)<<1)|(((byte2>>6)&1)<<2)|(((byte3>>6)&1)<<3);
-	  wsTCache2[t_index]=((byte0)&1)|(((byte1)&1)<<1)|(((byte2)&1)<<2)|(((byte3)&1)<<3);
-	  wsTCacheFlipped2[t_index++]=((byte0>>7)&1)|(((byte1>>7)&1)<<1)|(((byte2>>7)&1)<<2)|(((byte3>>7)&1)<<3);
-	 }
-	break;
-   default:
-	t_adr=0x4000+(number<<4);
-	t_index=number<<6;
- 	for(i=0;i<8;i++)
-	{
-	 byte0=wsRAM[t_adr++];
-	 byte1=wsRAM[t_adr++];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][0];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][0];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][1];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][1];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][2];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][2];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][3];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][3];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][4];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][4];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][5];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][5];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][6];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][6];
-	 wsTCache2[t_index]=tiles[byte0][byte1][0][7];
-	 wsTCacheFlipped2[t_index++]=tiles[byte0][byte1][1][7];
-	}
-   }	
+    MDFN_en64lsb(&cache[t_index], PlanePixels(src[0]) | (PlanePixels(src[1]) << 1));
+    MDFN_en64lsb(&cacheFlipped[t_index], PlanePixelsFlipped(src[0]) | (PlanePixelsFlipped(src[1]) << 1));
+   }
+   break;
   }
-  if(flipv)
-   line=7-line;
-  if(fliph)
-   memcpy(&wsTileRow[0],&wsTCacheFlipped2[(number<<6)|(line<<3)],8);
-  else
-   memcpy(&wsTileRow[0],&wsTCache2[(number<<6)|(line<<3)],8);
  }
 }
 
+void wsUpdateTiles(void)
+{
+ for(uint32 i = 0; i < DirtyTileCount; i++)
+ {
+  uint32 number = DirtyTiles[i] & 0x1FF;
+  uint32 bank = DirtyTiles[i] >> 9;
+  DecodeTile(number, bank);
+  (bank ? wsTCacheUpdate2 : wsTCacheUpdate)[number] = true;
+ }
+ DirtyTileCount = 0;
+}
+
 }
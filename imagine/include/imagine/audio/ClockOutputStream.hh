@@ -0,0 +1,73 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/defs.hh>
+#include <imagine/audio/Format.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/fs/FSDefs.hh>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <condition_variable>
+
+namespace IG::Audio
+{
+
+// Pulls samples on its own thread at the stream's nominal rate without a device, for
+// Api::NULL_SINK and Api::WAV_FILE. The WAV file isn't fed from the pulls, which are paced
+// by the wall clock and padded with silence on underruns, but from writeFile() as the
+// producer generates samples, so identical runs give identical files. It stays open across
+// close()/open() so pausing doesn't restart it, and is only finished on destruction
+class ClockOutputStream
+{
+public:
+	ClockOutputStream(bool writesFile = false): writesFile{writesFile} {}
+	~ClockOutputStream();
+	ClockOutputStream &operator=(ClockOutputStream &&) = delete;
+	StreamError open(OutputStreamConfig config);
+	void play();
+	void pause();
+	void close();
+	void flush() {}
+	bool isOpen() { return thread.joinable(); }
+	bool isPlaying() { return isOpen() && playing; }
+	explicit operator bool() const { return true; }
+	// appends samples to the WAV file in its format, if one is open
+	void writeFile(const void *samples, size_t frames, Format srcFormat);
+
+private:
+	std::thread thread;
+	std::mutex mutex;
+	std::condition_variable playingCond;
+	OnSamplesNeededDelegate onSamplesNeeded{};
+	FileIO file; // guarded by mutex since writeFile() runs on the producer's thread
+	FS::PathString filePath;
+	std::vector<uint8_t> convertBuff;
+	Format pcmFormat;
+	size_t periodFrames{};
+	uint32_t fileDataBytes{};
+	bool playing{};
+	bool quitting{};
+	bool writesFile{};
+
+	void run();
+	bool writeWavHeader();
+	void updateWavSizes();
+	void finishWavFile();
+};
+
+}
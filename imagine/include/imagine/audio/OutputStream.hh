@@ -23,6 +23,9 @@
 #elif defined __APPLE__
 #include <imagine/audio/coreaudio/CAOutputStream.hh>
 #else
+	#if CONFIG_PACKAGE_PIPEWIRE
+	#include <imagine/audio/pipewire/PWOutputStream.hh>
+	#endif
 	#if CONFIG_PACKAGE_PULSEAUDIO
 	#include <imagine/audio/pulseaudio/PAOutputStream.hh>
 	#endif
@@ -34,6 +37,8 @@
 #include <imagine/audio/defs.hh>
 #include <imagine/time/Time.hh>
 #include <imagine/audio/Format.hh>
+#include <imagine/audio/ClockOutputStream.hh>
+#include <imagine/util/string/CStringView.hh>
 #include <imagine/util/variant.hh>
 #include <variant>
 
@@ -45,7 +50,10 @@ struct OutputStreamConfig
 public:
 	Format format{};
 	OnSamplesNeededDelegate onSamplesNeeded{};
+	// called from the audio thread with the output's total latency when it's known or changes, only some APIs report it
+	OnLatencyChangedDelegate onLatencyChanged{};
 	Microseconds wantedLatencyHint{20000};
+	CStringView filePath{}; // output file for Api::WAV_FILE
 	bool startPlaying = true;
 
 	constexpr OutputStreamConfig() = default;
@@ -66,17 +74,21 @@ public:
 };
 
 #if defined __ANDROID__
-using OutputStreamVariant = std::variant<AAudioOutputStream, OpenSLESOutputStream, NullOutputStream>;
+using OutputStreamVariant = std::variant<AAudioOutputStream, OpenSLESOutputStream, ClockOutputStream, NullOutputStream>;
 #elif defined __APPLE__
-using OutputStreamVariant = std::variant<CAOutputStream, NullOutputStream>;
+using OutputStreamVariant = std::variant<CAOutputStream, ClockOutputStream, NullOutputStream>;
 #else
 	using OutputStreamVariant = std::variant<
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	PWOutputStream,
+	#endif
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	PAOutputStream,
 	#endif
 	#ifdef CONFIG_PACKAGE_ALSA
 	ALSAOutputStream,
 	#endif
+	ClockOutputStream,
 	NullOutputStream>;
 #endif
 
@@ -97,6 +109,8 @@ public:
 	bool isOpen();
 	bool isPlaying();
 	void reset();
+	// records samples as they're produced when the stream is Api::WAV_FILE
+	void writeFile(const void *samples, size_t frames, Format srcFormat);
 	explicit constexpr operator bool() const { return !std::holds_alternative<NullOutputStream>(*this); }
 };
 
@@ -16,6 +16,7 @@
 	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
 
 #include <imagine/config/defs.hh>
+#include <imagine/time/Time.hh>
 #include <imagine/util/DelegateFunc.hh>
 
 namespace IG::Audio
@@ -38,6 +39,10 @@ enum class Api: uint8_t
 	COREAUDIO,
 	OPENSL_ES,
 	AAUDIO,
+	PIPEWIRE,
+	// device-less outputs for headless runs, never returned by Manager::audioAPIs()
+	NULL_SINK,
+	WAV_FILE,
 };
 
 #if defined __ANDROID__
@@ -46,6 +51,9 @@ constexpr std::array systemApis{Api::AAUDIO, Api::OPENSL_ES};
 constexpr std::array systemApis{Api::COREAUDIO};
 #else
 	constexpr std::array systemApis{
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	Api::PIPEWIRE,
+	#endif
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	Api::PULSEAUDIO,
 	#endif
@@ -64,6 +72,7 @@ struct ApiDesc
 };
 
 using OnSamplesNeededDelegate = DelegateFunc<bool(void *buff, size_t frames)>;
+using OnLatencyChangedDelegate = DelegateFunc<void(Nanoseconds latency)>;
 
 enum class StreamError
 {
@@ -30,16 +30,24 @@
 namespace IG
 {
 class ApplicationContext;
+class FileIO;
 }
 
 namespace IG::Data
 {
 
+struct PixmapWriterParams
+{
+	// trade file size for encoding speed, may be ignored by platform encoders
+	bool fastCompression{};
+};
+
 class PixmapWriter final: public PixmapWriterImpl
 {
 public:
 	using PixmapWriterImpl::PixmapWriterImpl;
-	bool writeToFile(PixmapView, const char *path) const;
+	bool writeToFile(PixmapView, const char *path, PixmapWriterParams p = {}) const;
+	bool writeQOIToFile(PixmapView, FileIO &) const;
 };
 
 }
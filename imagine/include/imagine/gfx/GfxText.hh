@@ -48,7 +48,7 @@ public:
 	Text() = default;
 	Text(RendererTask &task, GlyphTextureSet *face): Text{task, UTF16String{}, face} {}
 	Text(RendererTask &task, UTF16Convertible auto &&str, GlyphTextureSet *face = nullptr):
-		textStr{IG_forward(str)}, face_{face}, quads{task, {.size = 1}} {}
+		textStr{IG_forward(str)}, face_{face}, quadIdxs{task, 1}, quads{task, {.size = 1}, quadIdxs} {}
 
 	void resetString(UTF16Convertible auto &&str)
 	{
@@ -95,6 +95,9 @@ protected:
 	int xSize{};
 	int ySize{};
 	GlyphSetMetrics metrics;
+	TextLayoutConfig layoutConfig{};
+	uint32_t atlasGeneration{};
+	QuadIndexArray<uint16_t> quadIdxs;
 	ITexQuads quads;
 
 	bool hasText() const;
@@ -20,6 +20,7 @@
 #include <imagine/gfx/Texture.hh>
 #include <imagine/util/container/VMemArray.hh>
 #include <string_view>
+#include <vector>
 
 namespace IG::Gfx
 {
@@ -28,8 +29,10 @@ constexpr auto glyphSamplerConfig = SamplerConfigs::noMipClamp;
 
 struct GlyphEntry
 {
-	Texture glyph;
+	FRect textureBounds; // normalized bounds within its atlas page
 	GlyphMetrics metrics;
+	uint16_t pageIdx;
+	bool cached;
 };
 
 class GlyphTextureSet
@@ -47,12 +50,21 @@ public:
 	const GlyphEntry *glyphEntry(Renderer &r, int c, bool allowCache = true);
 	GlyphSetMetrics metrics() const { return metrics_; }
 	int nominalHeight() const { return metrics().nominalHeight; }
+	const Texture &atlasPage(const GlyphEntry &e) const { return pages[e.pageIdx]; }
+	// changes whenever cached glyphs are freed and texture coordinates from glyphEntry() become invalid
+	uint32_t atlasGeneration() const { return atlasGeneration_; }
 	void freeCaches(uint32_t rangeToFreeBits);
 	void freeCaches() { freeCaches(~0); }
 
 private:
 	Font font;
 	VMemArray<GlyphEntry> glyphTable;
+	// glyphs are packed into pages in rows (shelves) as high as the tallest glyph in them
+	std::vector<Texture> pages;
+	WPt shelfPos{};
+	int shelfHeight{};
+	int pageSize{};
+	uint32_t atlasGeneration_{};
 	FontSettings settings;
 	FontSize faceSize;
 	GlyphSetMetrics metrics_;
@@ -61,6 +73,7 @@ private:
 	void calcMetrics(Renderer &r);
 	void resetGlyphTable();
 	bool cacheChar(Renderer &r, int c, int tableIdx);
+	bool allocGlyphRect(Renderer &r, WSize size, PixelFormat format, uint16_t &pageIdx, WPt &pos);
 };
 
 }
@@ -50,6 +50,7 @@ public:
 	operator TextureSpan() const;
 	operator const Texture&() const;
 	bool isExternal() const;
+	bool isSingleBuffered() const;
 };
 
 }
@@ -111,6 +111,7 @@ enum class TextureBufferMode : uint8_t
 	ANDROID_HARDWARE_BUFFER,
 	ANDROID_SURFACE_TEXTURE,
 	PBO,
+	HEADLESS,
 };
 
 enum class DrawAsyncMode : uint8_t
@@ -102,9 +102,39 @@ private:
 	UniqueGLBuffer pixelBuff{};
 };
 
+// Keeps pixel data only in system memory without creating or uploading to a GL texture,
+// for benchmarks and headless runs where frames are only consumed on the CPU
+class HeadlessStorage
+{
+public:
+	constexpr HeadlessStorage() = default;
+	HeadlessStorage(RendererTask &rTask, TextureConfig config);
+	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
+	LockedTextureBuffer lock(TextureBufferFlags bufferFlags = {});
+	void unlock(LockedTextureBuffer, TextureWriteFlags = {}) {}
+	// frames are never read by the renderer, so holding the lock doesn't block drawing
+	bool isSingleBuffered() const { return false; }
+	WSize size(int) const { return pixDesc.size; }
+	PixmapDesc pixmapDesc() const { return pixDesc; }
+	void setSampler(TextureSamplerConfig) {}
+	explicit operator bool() const { return (bool)storage; }
+	Renderer &renderer() const;
+	operator TextureSpan() const { return {}; }
+	operator const Texture&() const;
+	GLenum target() const { return GL_TEXTURE_2D; }
+
+private:
+	RendererTask *rTaskPtr{};
+	std::unique_ptr<char[]> storage;
+	PixmapDesc pixDesc{};
+
+	void initBuffer(PixmapDesc desc);
+};
+
 using GLPixmapBufferTextureVariant = std::variant<
 	GLSystemMemoryStorage,
-	GLPixelBufferStorage
+	GLPixelBufferStorage,
+	HeadlessStorage
 	#ifdef __ANDROID__
 	, AHardwareSingleBufferStorage
 	, GraphicSingleBufferStorage
@@ -128,6 +158,7 @@ protected:
 	void initWithPixelBuffer(RendererTask &rTask, TextureConfig config,  bool singleBuffer = false);
 	void initWithHardwareBuffer(RendererTask &rTask, TextureConfig config, bool singleBuffer = false);
 	void initWithSurfaceTexture(RendererTask &rTask, TextureConfig config, bool singleBuffer = false);
+	void initHeadless(RendererTask &rTask, TextureConfig config);
 };
 
 using PixmapBufferTextureImpl = GLPixmapBufferTexture;
@@ -33,6 +33,7 @@ public:
 	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags);
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags);
+	bool isSingleBuffered() const { return true; }
 
 protected:
 	Buffer buffer{};
@@ -47,6 +48,7 @@ public:
 	bool setFormat(PixmapDesc, ColorSpace, TextureSamplerConfig);
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags);
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags);
+	bool isSingleBuffered() const { return false; }
 
 protected:
 	struct EGLImageDeleter
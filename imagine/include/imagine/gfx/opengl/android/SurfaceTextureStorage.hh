@@ -35,6 +35,7 @@ public:
 	bool setFormat(PixmapDesc desc, ColorSpace, TextureSamplerConfig);
 	LockedTextureBuffer lock(TextureBufferFlags bufferFlags);
 	void unlock(LockedTextureBuffer lockBuff, TextureWriteFlags writeFlags);
+	bool isSingleBuffered() const { return singleBuffered; }
 
 protected:
 	jobject surfaceTex{};
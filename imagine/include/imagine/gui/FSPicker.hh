@@ -25,9 +25,11 @@
 #include <imagine/thread/WorkThread.hh>
 #include <imagine/util/DelegateFunc.hh>
 #include <imagine/util/string/CStringView.hh>
+#include <imagine/time/Time.hh>
 #include <vector>
 #include <string>
 #include <string_view>
+#include <mutex>
 
 namespace IG::FS
 {
@@ -49,15 +51,25 @@ public:
 
 	struct FileEntry
 	{
-		static constexpr auto isDirFlag = bit(0);
-
 		std::string path;
+		std::string name;
+		bool isDir{};
+	};
+
+	// menu item for the entry at entryIdx, only created for the rows being drawn
+	struct FileItem
+	{
 		TextMenuItem text;
+		size_t entryIdx{noEntry};
 
-		FileEntry(ViewAttachParams attach, auto &&path, UTF16Convertible auto &&name):
-			path{IG_forward(path)}, text{IG_forward(name), attach} {}
-		bool isDir() const { return text.flags.user & isDirFlag; }
-		TextMenuItem &menuItem() { return text; }
+		static constexpr size_t noEntry = SIZE_MAX;
+	};
+
+	struct DirListing
+	{
+		FS::PathString path;
+		WallClockTimePoint lastWriteTime;
+		std::vector<FileEntry> entries;
 	};
 
 	enum class DepthMode { increment, decrement, reset };
@@ -88,18 +100,30 @@ public:
 	bool onDocumentPicked(const DocumentPickerEvent&) override;
 
 protected:
+	static constexpr size_t minCachedListingSize = 64; // also the first batch size posted while listing
+	static constexpr size_t maxPostedEntries = 4096;
+	static constexpr size_t maxCachedListings = 4;
+
 	FilterFunc filter{};
 	ViewStack controller;
 	OnChangePathDelegate onChangePath_;
 	OnSelectPathDelegate onSelectPath_;
 	std::vector<FileEntry> dir;
+	std::vector<FileItem> fileItems;
 	std::vector<TableUIState> fileUIStates;
+	std::vector<DirListing> cachedListings;
 	FS::RootedPath root;
 	Gfx::Text msgText;
 	CustomEvent dirListEvent{"FSPicker::dirListEvent", {}};
 	TableUIState newFileUIState{};
+	std::mutex pendingDirMutex;
+	std::vector<FileEntry> pendingDir; // entries listed by dirListThread not yet merged into dir
+	bool pendingDirComplete{};
+	FS::PathString listingPath; // directory currently being listed and its write time when the listing started
+	WallClockTimePoint listingWriteTime;
 	Mode mode_{};
 	bool showHiddenFiles_{};
+	bool dirListComplete{true};
 	WorkThread dirListThread{};
 
 	void changeDirByInput(CStringView path, FS::RootPathInfo, const Input::Event &,
@@ -109,6 +133,14 @@ protected:
 	TableView &fileTableView();
 	void startDirectoryListThread(CStringView path);
 	void listDirectory(CStringView path, ThreadStop &stop);
+	void postPendingEntries(std::vector<FileEntry> &, bool complete);
+	bool mergePendingEntries();
+	bool useCachedListing(CStringView path);
+	void cacheListing();
+	TextMenuItem &fileItem(size_t idx);
+	void resizeFileItems();
+	void invalidateFileItems();
+	void onSelectEntry(size_t idx, const Input::Event &);
 	void setEmptyPath(std::string_view message);
 };
 
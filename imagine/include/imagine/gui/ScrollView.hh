@@ -67,6 +67,9 @@ protected:
 	void drawScrollContent(Gfx::RendererCommands &cmds) const;
 	bool scrollInputEvent(const Input::MotionEvent &);
 	void stopScrollAnimation();
+	void scrolled();
+	// called on the main thread after the scroll offset changes, before the next draw
+	virtual void onScroll() {}
 };
 
 }
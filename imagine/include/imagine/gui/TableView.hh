@@ -83,6 +83,9 @@ public:
 	void resetName(UTF16Convertible auto &&name) { nameStr = IG_forward(name); }
 	void resetName() { nameStr.clear(); }
 	void resetItemSource(ItemSourceDelegate src = [](ItemMessage) -> ItemReply { return 0uz; }) { itemSrc = src; }
+	// For item sources that create items on demand, only the cells around the visible area are requested
+	// outside of input handling and they must be returned already placed and ready to draw
+	void setLazyItems(bool on) { lazyItems = on; }
 
 protected:
 	static constexpr size_t maxSeparators = 32;
@@ -98,6 +101,7 @@ protected:
 	bool onlyScrollIfNeeded = false;
 	bool selectedIsActivated = false;
 	bool hasFocus = true;
+	bool lazyItems = false;
 
 	void setYCellSize(int s);
 	WRect focusRect();
@@ -106,6 +110,8 @@ protected:
 	int prevSelectableElement(int start, int items);
 	bool handleTableInput(const Input::Event &, bool &movedSelected);
 	virtual void drawElement(Gfx::RendererCommands &__restrict__, size_t i, MenuItem &item, WRect rect, int xIndent) const;
+	void onScroll() override;
+	void prepareVisibleCells();
 
 	auto& item(this auto&& self, ItemSourceDelegate src, size_t idx)
 	{
@@ -98,8 +98,10 @@ using CPUMask = uint32_t;
 static constexpr int maxCPUs = 32;
 
 void setThreadCPUAffinityMask(std::span<const ThreadId>, CPUMask mask);
+CPUMask threadCPUAffinityMask(ThreadId);
 void setThreadPriority(ThreadId, int nice);
 void setThisThreadPriority(int nice);
+int threadPriority(ThreadId);
 int thisThreadPriority();
 ThreadId thisThreadId();
 
@@ -0,0 +1,107 @@
+#pragma once
+
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/config/defs.hh>
+#include <imagine/thread/Thread.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/util/DelegateFunc.hh>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <ctime>
+
+namespace IG
+{
+
+enum class ThreadRole : uint8_t
+{
+	// does work needed to produce each frame, shares the frame threads' affinity, priority, and performance hints
+	frame,
+	// only shares the priority setting
+	background,
+};
+
+struct RegisteredThread
+{
+	ThreadId id{};
+	const char *name{};
+	ThreadRole role{};
+	Nanoseconds cpuTime{};
+};
+
+// Tracks helper threads created outside the app's own tasks so affinity, priority,
+// and performance hint settings apply to them, including threads that start later
+class ThreadRegistry
+{
+public:
+	class Registration
+	{
+	public:
+		constexpr Registration() = default;
+		constexpr Registration(ThreadRegistry &registry, ThreadId id):
+			registryPtr{&registry}, id{id} {}
+		Registration(Registration &&o) noexcept { *this = std::move(o); }
+		Registration &operator=(Registration &&o) noexcept
+		{
+			reset();
+			registryPtr = std::exchange(o.registryPtr, nullptr);
+			id = o.id;
+			return *this;
+		}
+		~Registration() { reset(); }
+		void reset();
+
+	private:
+		ThreadRegistry *registryPtr{};
+		ThreadId id{};
+	};
+
+	using OnChangeDelegate = DelegateFunc<void()>;
+
+	// registers the calling thread until the returned object is destroyed, name must have static storage
+	[[nodiscard]] Registration registerThisThread(const char *name, ThreadRole role = ThreadRole::frame);
+	void addFrameThreadIds(std::vector<ThreadId> &) const;
+	// mask of 0 allows any CPU
+	void setCPUAffinityMask(CPUMask);
+	void setPriority(int nice);
+	// called on the registering thread when the set of frame threads changes
+	void setOnChange(OnChangeDelegate del) { std::scoped_lock lock{mutex}; onChange = del; }
+	std::vector<RegisteredThread> threads() const;
+
+private:
+	struct Entry
+	{
+		ThreadId id{};
+		const char *name{};
+		ThreadRole role{};
+		#ifdef __linux__
+		clockid_t cpuClock{};
+		#endif
+	};
+
+	mutable std::mutex mutex;
+	std::vector<Entry> entries;
+	OnChangeDelegate onChange;
+	CPUMask cpuMask{};
+	std::optional<int> nice;
+
+	void unregister(ThreadId);
+};
+
+ThreadRegistry &helperThreads();
+
+}
@@ -48,6 +48,9 @@ void Manager::endSession() {}
 
 static constexpr ApiDesc apiDesc[]
 {
+	#ifdef CONFIG_PACKAGE_PIPEWIRE
+	{"PipeWire", Api::PIPEWIRE},
+	#endif
 	#ifdef CONFIG_PACKAGE_PULSEAUDIO
 	{"PulseAudio", Api::PULSEAUDIO},
 	#endif
@@ -0,0 +1,192 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/ClockOutputStream.hh>
+#include <imagine/audio/OutputStream.hh>
+#include <imagine/time/Time.hh>
+#include <imagine/logger/logger.h>
+#include <memory>
+#include <string_view>
+
+namespace IG::Audio
+{
+
+constexpr SystemLogger log{"ClockAudio"};
+
+ClockOutputStream::~ClockOutputStream()
+{
+	close();
+	std::scoped_lock lock{mutex};
+	if(file)
+		finishWavFile();
+}
+
+StreamError ClockOutputStream::open(OutputStreamConfig config)
+{
+	if(isOpen())
+	{
+		log.info("audio already open");
+		return {};
+	}
+	{
+		std::scoped_lock lock{mutex};
+		if(file && (std::string_view{filePath} != std::string_view{config.filePath} || pcmFormat != config.format))
+		{
+			log.info("output changed, finishing WAV file:{}", filePath);
+			finishWavFile();
+		}
+		pcmFormat = config.format;
+		if(writesFile && !file)
+		{
+			file = {config.filePath, OpenFlags::testNewFile()};
+			if(!file || !writeWavHeader())
+			{
+				log.error("can't create WAV file:{}", config.filePath);
+				file = {};
+				return StreamError::BadArgument;
+			}
+			filePath = config.filePath;
+		}
+	}
+	onSamplesNeeded = config.onSamplesNeeded;
+	const auto wantedLatency = config.wantedLatencyHint.count() ? config.wantedLatencyHint : Microseconds{10000};
+	periodFrames = std::max(size_t(pcmFormat.timeToFrames(wantedLatency)), 1zu);
+	playing = config.startPlaying;
+	quitting = false;
+	thread = std::thread{[this]{ run(); }};
+	log.info("opened {} stream with period:{} frames", writesFile ? "WAV file" : "null", periodFrames);
+	return {};
+}
+
+void ClockOutputStream::run()
+{
+	auto buff = std::make_unique<uint8_t[]>(pcmFormat.framesToBytes(periodFrames));
+	SteadyClockTimePoint startTime{};
+	uint64_t framesPulled{};
+	for(;;)
+	{
+		{
+			std::unique_lock lock{mutex};
+			if(!playing)
+			{
+				playingCond.wait(lock, [&]{ return playing || quitting; });
+				// restart the clock so time spent paused isn't made up with a burst of pulls
+				startTime = {};
+			}
+			if(quitting)
+				return;
+		}
+		if(startTime == SteadyClockTimePoint{})
+		{
+			startTime = SteadyClock::now();
+			framesPulled = 0;
+		}
+		// wake times come from the total frame count so rounding the period doesn't drift the rate
+		framesPulled += periodFrames;
+		std::this_thread::sleep_until(startTime + duration_cast<SteadyClockTime>(pcmFormat.framesToTime(framesPulled)));
+		onSamplesNeeded(buff.get(), periodFrames);
+	}
+}
+
+void ClockOutputStream::writeFile(const void *samples, size_t frames, Format srcFormat)
+{
+	std::scoped_lock lock{mutex};
+	if(!file)
+		return;
+	auto bytes = pcmFormat.framesToBytes(frames);
+	if(srcFormat.sample != pcmFormat.sample || srcFormat.channels != pcmFormat.channels)
+	{
+		if(convertBuff.size() < bytes)
+			convertBuff.resize(bytes);
+		pcmFormat.copyFrames(convertBuff.data(), samples, frames, srcFormat);
+		samples = convertBuff.data();
+	}
+	if(file.write(samples, bytes) == ssize_t(bytes))
+		fileDataBytes += bytes;
+}
+
+void ClockOutputStream::play()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		playing = true;
+	}
+	playingCond.notify_one();
+}
+
+void ClockOutputStream::pause()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	std::scoped_lock lock{mutex};
+	playing = false;
+}
+
+void ClockOutputStream::close()
+{
+	if(!isOpen())
+		return;
+	{
+		std::scoped_lock lock{mutex};
+		quitting = true;
+	}
+	playingCond.notify_one();
+	thread.join();
+	playing = false;
+	// keep appending after the next open(), but leave a valid file in case that never happens
+	std::scoped_lock lock{mutex};
+	if(file)
+		updateWavSizes();
+}
+
+bool ClockOutputStream::writeWavHeader()
+{
+	const uint16_t formatTag = pcmFormat.sample.isFloat() ? 3 : 1; // IEEE float or integer PCM
+	const uint16_t channels = pcmFormat.channels;
+	const uint32_t rate = pcmFormat.rate;
+	const uint16_t frameBytes = pcmFormat.bytesPerFrame();
+	const uint16_t sampleBits = pcmFormat.sample.bytes() * 8;
+	constexpr std::string_view riffStart{"RIFF\0\0\0\0WAVEfmt ", 16};
+	constexpr std::string_view dataStart{"data\0\0\0\0", 8};
+	fileDataBytes = 0;
+	// RIFF and data chunk sizes are filled in by finishWavFile()
+	return file.write(riffStart.data(), riffStart.size()) == ssize_t(riffStart.size()) &&
+		file.put(uint32_t(16)) > 0 &&
+		file.put(formatTag) > 0 &&
+		file.put(channels) > 0 &&
+		file.put(rate) > 0 &&
+		file.put(uint32_t(rate * frameBytes)) > 0 &&
+		file.put(frameBytes) > 0 &&
+		file.put(sampleBits) > 0 &&
+		file.write(dataStart.data(), dataStart.size()) == ssize_t(dataStart.size());
+}
+
+void ClockOutputStream::updateWavSizes()
+{
+	file.put(uint32_t(36 + fileDataBytes), 4);
+	file.put(fileDataBytes, 40);
+}
+
+void ClockOutputStream::finishWavFile()
+{
+	updateWavSizes();
+	log.info("wrote {} bytes of samples to WAV file:{}", fileDataBytes, filePath);
+	file = {};
+	filePath.clear();
+}
+
+}
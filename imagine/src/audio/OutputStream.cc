@@ -25,9 +25,18 @@ namespace IG::Audio
 
 void OutputStream::setApi(const Manager &mgr, Api api)
 {
+	switch(api)
+	{
+		case Api::NULL_SINK: emplace<ClockOutputStream>(); return;
+		case Api::WAV_FILE: emplace<ClockOutputStream>(true); return;
+		default: break;
+	}
 	api = mgr.makeValidAPI(api);
 	switch(api)
 	{
+		#ifdef CONFIG_PACKAGE_PIPEWIRE
+		case Api::PIPEWIRE: emplace<PWOutputStream>(); return;
+		#endif
 		#ifdef CONFIG_PACKAGE_PULSEAUDIO
 		case Api::PULSEAUDIO: emplace<PAOutputStream>(); return;
 		#endif
@@ -55,6 +64,12 @@ bool OutputStream::isOpen() { return visit([&](auto &v){ return v.isOpen(); });
 bool OutputStream::isPlaying() { return visit([&](auto &v){ return v.isPlaying(); }); }
 void OutputStream::reset() { emplace<NullOutputStream>(); }
 
+void OutputStream::writeFile(const void *samples, size_t frames, Format srcFormat)
+{
+	if(auto clockStream = std::get_if<ClockOutputStream>(this))
+		clockStream->writeFile(samples, frames, srcFormat);
+}
+
 OutputStreamConfig Manager::makeNativeOutputStreamConfig() const
 {
 	return {nativeFormat()};
@@ -1,6 +1,6 @@
 ifndef inc_audio
 inc_audio := 1
 
-SRC += audio/Format.cc
+SRC += audio/Format.cc audio/ClockOutputStream.cc
 
 endif
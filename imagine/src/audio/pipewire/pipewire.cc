@@ -0,0 +1,261 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/audio/pipewire/PWOutputStream.hh>
+#include <imagine/audio/OutputStream.hh>
+#include <imagine/logger/logger.h>
+#include <imagine/util/format.hh>
+#include <pipewire/pipewire.h>
+#include <spa/param/audio/format-utils.h>
+#include <algorithm>
+#include <bit>
+
+namespace IG::Audio
+{
+
+constexpr SystemLogger log{"PipeWire"};
+
+// latency changes smaller than this aren't reported to avoid calling the delegate every cycle
+constexpr Nanoseconds latencyReportThreshold = Milliseconds{1};
+
+static spa_audio_format pcmFormatToSPA(const SampleFormat &format)
+{
+	switch(format.bytes())
+	{
+		case 4 : return format.isFloat() ? SPA_AUDIO_FORMAT_F32 : SPA_AUDIO_FORMAT_S32;
+		case 2 : return SPA_AUDIO_FORMAT_S16;
+		case 1 : return SPA_AUDIO_FORMAT_U8;
+		default:
+			bug_unreachable("bytes == %d", format.bytes());
+	}
+}
+
+// the graph runs in power of 2 quantums, request the one closest above the wanted latency
+static uint32_t nodeQuantum(Microseconds wantedLatency, int rate)
+{
+	auto frames = uint32_t(int64_t(rate) * wantedLatency.count() / 1000000);
+	return std::clamp(std::bit_ceil(frames), 64u, 8192u);
+}
+
+PWOutputStream::PWOutputStream()
+{
+	pw_init(nullptr, nullptr);
+	loop = pw_thread_loop_new("PipeWire", nullptr);
+	if(!loop)
+	{
+		log.error("unable to create thread loop");
+		return;
+	}
+	if(pw_thread_loop_start(loop) < 0)
+	{
+		log.error("unable to start thread loop");
+		pw_thread_loop_destroy(loop);
+		loop = {};
+	}
+}
+
+PWOutputStream::~PWOutputStream()
+{
+	if(loop)
+	{
+		close();
+		pw_thread_loop_stop(loop);
+		pw_thread_loop_destroy(loop);
+	}
+	pw_deinit();
+}
+
+StreamError PWOutputStream::open(OutputStreamConfig config)
+{
+	if(isOpen())
+	{
+		log.info("audio already open");
+		return {};
+	}
+	if(!loop) [[unlikely]]
+	{
+		return StreamError::NotInitialized;
+	}
+	static const pw_stream_events streamEvents
+	{
+		.version = PW_VERSION_STREAM_EVENTS,
+		.state_changed = [](void *thisPtr, pw_stream_state, pw_stream_state state, const char *error)
+		{
+			if(state == PW_STREAM_STATE_ERROR)
+				log.error("stream error:{}", error ? error : "unknown");
+			pw_thread_loop_signal(static_cast<PWOutputStream*>(thisPtr)->loop, false);
+		},
+		.process = [](void *thisPtr) { static_cast<PWOutputStream*>(thisPtr)->process(); },
+	};
+	auto format = config.format;
+	pcmFormat = format;
+	onSamplesNeeded = config.onSamplesNeeded;
+	onLatencyChanged = config.onLatencyChanged;
+	reportedLatency = {};
+	const auto wantedLatency = config.wantedLatencyHint.count() ? config.wantedLatencyHint : Microseconds{5000};
+	const auto quantum = nodeQuantum(wantedLatency, format.rate);
+	auto props = pw_properties_new(
+		PW_KEY_MEDIA_TYPE, "Audio",
+		PW_KEY_MEDIA_CATEGORY, "Playback",
+		PW_KEY_MEDIA_ROLE, "Game",
+		nullptr);
+	pw_properties_setf(props, PW_KEY_NODE_LATENCY, "%u/%d", quantum, format.rate);
+	pw_thread_loop_lock(loop);
+	stream = pw_stream_new_simple(pw_thread_loop_get_loop(loop), "Playback", props, &streamEvents, this);
+	if(!stream)
+	{
+		pw_thread_loop_unlock(loop);
+		log.error("error creating stream");
+		return StreamError::BadArgument;
+	}
+	spa_audio_info_raw info{.format = pcmFormatToSPA(format.sample), .rate = uint32_t(format.rate), .channels = uint32_t(format.channels)};
+	if(format.channels == 2)
+	{
+		info.position[0] = SPA_AUDIO_CHANNEL_FL;
+		info.position[1] = SPA_AUDIO_CHANNEL_FR;
+	}
+	else
+	{
+		info.position[0] = SPA_AUDIO_CHANNEL_MONO;
+	}
+	uint8_t podBuff[1024];
+	spa_pod_builder podBuilder = SPA_POD_BUILDER_INIT(podBuff, sizeof(podBuff));
+	const spa_pod *params[]{spa_format_audio_raw_build(&podBuilder, SPA_PARAM_EnumFormat, &info)};
+	// process runs on the realtime data thread and only reads from the caller's buffer, so it doesn't need the loop lock
+	auto flags = pw_stream_flags(PW_STREAM_FLAG_AUTOCONNECT | PW_STREAM_FLAG_MAP_BUFFERS | PW_STREAM_FLAG_RT_PROCESS |
+		(config.startPlaying ? 0 : PW_STREAM_FLAG_INACTIVE));
+	if(pw_stream_connect(stream, PW_DIRECTION_OUTPUT, PW_ID_ANY, flags, params, std::size(params)) < 0)
+	{
+		pw_thread_loop_unlock(loop);
+		log.error("error connecting playback stream");
+		close();
+		return StreamError::BadArgument;
+	}
+	for(;;)
+	{
+		auto state = pw_stream_get_state(stream, nullptr);
+		if(state == PW_STREAM_STATE_PAUSED || state == PW_STREAM_STATE_STREAMING)
+			break;
+		if(state == PW_STREAM_STATE_ERROR || pw_thread_loop_timed_wait(loop, 2))
+		{
+			pw_thread_loop_unlock(loop);
+			log.error("error connecting playback stream async");
+			close();
+			return StreamError::BadArgument;
+		}
+	}
+	isActive = config.startPlaying;
+	pw_thread_loop_unlock(loop);
+	log.info("opened stream with node latency:{}/{} ({})", quantum, format.rate, format.framesToTime(quantum));
+	return {};
+}
+
+void PWOutputStream::process()
+{
+	auto pwBuff = pw_stream_dequeue_buffer(stream);
+	if(!pwBuff) [[unlikely]]
+		return;
+	auto &data = pwBuff->buffer->datas[0];
+	if(!data.data) [[unlikely]]
+	{
+		pw_stream_queue_buffer(stream, pwBuff);
+		return;
+	}
+	const uint32_t frameBytes = pcmFormat.bytesPerFrame();
+	uint32_t frames = data.maxsize / frameBytes;
+	if(pwBuff->requested)
+		frames = std::min(frames, uint32_t(pwBuff->requested));
+	assumeExpr(onSamplesNeeded);
+	onSamplesNeeded(data.data, frames);
+	data.chunk->offset = 0;
+	data.chunk->stride = frameBytes;
+	data.chunk->size = frames * frameBytes;
+	pw_stream_queue_buffer(stream, pwBuff);
+	if(onLatencyChanged)
+		updateLatency(frames);
+}
+
+void PWOutputStream::updateLatency(size_t framesWritten)
+{
+	pw_time time;
+	if(pw_stream_get_time_n(stream, &time, sizeof(time)) < 0 || !time.rate.denom) [[unlikely]]
+		return;
+	// delay is in graph clock ticks, add the quantum just written since it plays after the queued samples
+	auto delay = Nanoseconds{time.delay * SPA_NSEC_PER_SEC * time.rate.num / time.rate.denom};
+	auto latency = delay + duration_cast<Nanoseconds>(pcmFormat.framesToTime(framesWritten));
+	if(std::chrono::abs(latency - reportedLatency) < latencyReportThreshold)
+		return;
+	reportedLatency = latency;
+	onLatencyChanged(latency);
+}
+
+void PWOutputStream::play()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	pw_thread_loop_lock(loop);
+	pw_stream_set_active(stream, true);
+	pw_thread_loop_unlock(loop);
+	isActive = true;
+}
+
+void PWOutputStream::pause()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	log.info("pausing playback");
+	pw_thread_loop_lock(loop);
+	pw_stream_set_active(stream, false);
+	pw_thread_loop_unlock(loop);
+	isActive = false;
+}
+
+void PWOutputStream::close()
+{
+	if(!isOpen())
+		return;
+	pw_thread_loop_lock(loop);
+	pw_stream_destroy(stream);
+	pw_thread_loop_unlock(loop);
+	stream = {};
+	isActive = false;
+}
+
+void PWOutputStream::flush()
+{
+	if(!isOpen()) [[unlikely]]
+		return;
+	log.info("clearing queued samples");
+	pw_thread_loop_lock(loop);
+	pw_stream_flush(stream, false);
+	pw_thread_loop_unlock(loop);
+}
+
+bool PWOutputStream::isOpen()
+{
+	return stream;
+}
+
+bool PWOutputStream::isPlaying()
+{
+	return isOpen() && isActive;
+}
+
+PWOutputStream::operator bool() const
+{
+	return loop;
+}
+
+}
@@ -1,5 +1,12 @@
 ifeq ($(ENV), linux)
  ifneq ($(SUBENV), pandora)
+  # PipeWire is optional, only build it when pkg-config finds the library unless overridden with linuxAudioPipeWire=0/1
+  ifndef linuxAudioPipeWire
+   linuxAudioPipeWire := $(shell PKG_CONFIG_PATH=$(PKG_CONFIG_PATH) pkg-config --exists libpipewire-0.3 && echo 1)
+  endif
+  ifeq ($(linuxAudioPipeWire), 1)
+   include $(imagineSrcDir)/audio/pipewire/build.mk
+  endif
   include $(imagineSrcDir)/audio/pulseaudio/build.mk
   include $(imagineSrcDir)/audio/alsa/build.mk
  else
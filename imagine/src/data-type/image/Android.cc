@@ -112,7 +112,7 @@ BitmapWriter::BitmapWriter(ApplicationContext ctx):
 	jWritePNG = {env, baseActivityCls, "writePNG", "(Landroid/graphics/Bitmap;Ljava/lang/String;)Z"};
 }
 
-bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
+bool PixmapWriter::writeToFile(PixmapView pix, const char *path, PixmapWriterParams) const
 {
 	auto env = app().thisThreadJniEnv();
 	auto aFormat = pix.format() == PixelFmtRGB565 ? ANDROID_BITMAP_FORMAT_RGB_565 : ANDROID_BITMAP_FORMAT_RGBA_8888;
@@ -395,7 +395,7 @@ PixmapImage PixmapReader::loadAsset(const char *name, PixmapReaderParams params,
 	return load(appContext().openAsset(name, {.accessHint = IOAccessHint::All}, appName), params);
 }
 
-bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
+bool PixmapWriter::writeToFile(PixmapView pix, const char *path, PixmapWriterParams params) const
 {
 	FileIO fp{path, OpenFlags::testNewFile()};
 	if(!fp)
@@ -439,6 +439,11 @@ bool PixmapWriter::writeToFile(PixmapView pix, const char *path) const
 		PNG_COLOR_TYPE_RGB,
 		PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT,
 		PNG_FILTER_TYPE_DEFAULT);
+	if(params.fastCompression)
+	{
+		png_set_compression_level(pngPtr, 1);
+		png_set_filter(pngPtr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+	}
 	png_write_info(pngPtr, infoPtr);
 	{
 		MemPixmap tempMemPix{{pix.size(), PixelFmtRGB888}};
@@ -0,0 +1,105 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/data-type/image/PixmapWriter.hh>
+#include <imagine/io/FileIO.hh>
+#include <imagine/pixmap/MemPixmap.hh>
+#include <imagine/util/ranges.hh>
+#include <imagine/logger/logger.h>
+#include <array>
+#include <vector>
+
+namespace IG::Data
+{
+
+constexpr SystemLogger log{"QOI"};
+
+// Encoder for the Quite OK Image format (https://qoiformat.org), writing opaque RGB images
+bool PixmapWriter::writeQOIToFile(PixmapView srcPix, FileIO &file) const
+{
+	struct RGBA { uint8_t r, g, b, a; bool operator==(const RGBA &) const = default; };
+	MemPixmap tempMemPix{{srcPix.size(), PixelFmtRGB888}};
+	auto pix = tempMemPix.view();
+	pix.writeConverted(srcPix);
+	std::vector<uint8_t> out;
+	out.reserve(14 + pix.w() * pix.h() * 4 + 8);
+	auto put32BE = [&](uint32_t v) { out.insert(out.end(), {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)}); };
+	out.insert(out.end(), {'q', 'o', 'i', 'f'});
+	put32BE(pix.w());
+	put32BE(pix.h());
+	out.insert(out.end(), {3, 0}); // RGB channels, sRGB color space
+	std::array<RGBA, 64> index{};
+	RGBA prev{0, 0, 0, 255};
+	int run{};
+	auto flushRun = [&]
+	{
+		out.push_back(0xc0 | (run - 1)); // QOI_OP_RUN
+		run = 0;
+	};
+	for(auto y : iotaCount(pix.h()))
+	{
+		auto row = static_cast<const uint8_t*>(pix.data()) + y * pix.pitchBytes();
+		for(auto x : iotaCount(pix.w()))
+		{
+			RGBA px{row[x * 3], row[x * 3 + 1], row[x * 3 + 2], 255};
+			if(px == prev)
+			{
+				if(++run == 62)
+					flushRun();
+				continue;
+			}
+			if(run)
+				flushRun();
+			auto hash = (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+			if(index[hash] == px)
+			{
+				out.push_back(hash); // QOI_OP_INDEX
+			}
+			else
+			{
+				index[hash] = px;
+				int8_t vr = px.r - prev.r;
+				int8_t vg = px.g - prev.g;
+				int8_t vb = px.b - prev.b;
+				int8_t vgr = vr - vg;
+				int8_t vgb = vb - vg;
+				if(vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+				{
+					out.push_back(0x40 | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)); // QOI_OP_DIFF
+				}
+				else if(vgr > -9 && vgr < 8 && vg > -33 && vg < 32 && vgb > -9 && vgb < 8)
+				{
+					out.insert(out.end(), {uint8_t(0x80 | (vg + 32)), uint8_t((vgr + 8) << 4 | (vgb + 8))}); // QOI_OP_LUMA
+				}
+				else
+				{
+					out.insert(out.end(), {0xfe, px.r, px.g, px.b}); // QOI_OP_RGB
+				}
+			}
+			prev = px;
+		}
+	}
+	if(run)
+		flushRun();
+	out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+	if(file.write(out.data(), out.size()) != ssize_t(out.size()))
+	{
+		log.error("error writing QOI data");
+		return false;
+	}
+	return true;
+}
+
+}
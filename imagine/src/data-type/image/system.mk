@@ -1,3 +1,5 @@
+SRC += data-type/image/QOI.cc
+
 ifeq ($(ENV), ios)
  include $(imagineSrcDir)/data-type/image/quartz2d.mk
 else ifeq ($(ENV), android)
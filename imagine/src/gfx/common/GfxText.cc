@@ -50,6 +50,11 @@ void Text::makeGlyphs()
 	{
 		face_->glyphEntry(renderer(), c);
 	}
+	if(atlasGeneration != face_->atlasGeneration())
+	{
+		// glyphs were re-cached at new atlas positions, update the texture bounds of the compiled quads
+		compile(layoutConfig);
+	}
 }
 
 auto writeSpan(Renderer &r, auto quadsIt, WPt pos, std::u16string_view strView, GlyphTextureSet *face_, int spaceSize)
@@ -67,12 +72,12 @@ auto writeSpan(Renderer &r, auto quadsIt, WPt pos, std::u16string_view strView,
 			pos.x += spaceSize;
 			continue;
 		}
-		auto &[glyph, metrics] = *gly;
+		auto &metrics = gly->metrics;
 		auto drawPos = pos.as<int16_t>() + metrics.offset.negateY();
 		pos.x += metrics.xAdvance;
 		ITexQuad quad
 		{
-			{.bounds = {drawPos, (drawPos + metrics.size)}, .textureBounds = ITexQuad::unitTexCoordRect()}
+			{.bounds = {drawPos, (drawPos + metrics.size)}, .textureBounds = ITexQuad::remapTexCoordRect(gly->textureBounds)}
 		};
 		quadsIt = std::ranges::copy(quad.v, quadsIt).out;
 	}
@@ -94,6 +99,8 @@ bool Text::compile(TextLayoutConfig conf)
 		textStr.resize(stringSize());
 		sizeBeforeLineSpans = {};
 	}
+	layoutConfig = conf;
+	atlasGeneration = face_->atlasGeneration();
 	metrics = face_->metrics();
 	auto [nominalHeight, spaceSize, yLineStart] = metrics;
 	int lines = 1;
@@ -171,6 +178,7 @@ bool Text::compile(TextLayoutConfig conf)
 	// write vertex data
 	WPt pos{0, nominalHeight - yLineStart};
 	quads.reset({.size = size_t(charIdx)});
+	quadIdxs.reserve(charIdx);
 	auto mappedVerts = quads.map();
 	if(lines > 1)
 	{
@@ -205,28 +213,6 @@ bool Text::compile(TextLayoutConfig conf)
 	return true;
 }
 
-static int drawSpan(RendererCommands &cmds, std::u16string_view strView, int spriteOffset, GlyphTextureSet *face_)
-{
-	auto &renderer = cmds.renderer();
-	auto &basicEffect = cmds.basicEffect();
-	for(auto c : strView)
-	{
-		if(c == '\n')
-		{
-			continue;
-		}
-		auto gly = face_->glyphEntry(renderer, c, false);
-		if(!gly)
-		{
-			//log.info("no glyph for {:X}", c);
-			continue;
-		}
-		auto &[glyph, metrics] = *gly;
-		basicEffect.drawSprite(cmds, spriteOffset++, glyph);
-	}
-	return spriteOffset;
-}
-
 void Text::draw(RendererCommands &cmds, WPt pos, _2DOrigin o, Color c) const
 {
 	cmds.setColor(c);
@@ -246,25 +232,38 @@ void Text::draw(RendererCommands &cmds, WPt pos, _2DOrigin o) const
 	//log.info("drawing text @ {},{}, size:{},{}", xPos, yPos, xSize, ySize);
 	cmds.basicEffect().setModelView(cmds, Mat4::makeTranslate({pos.x, pos.y, 0}));
 	cmds.setVertexArray(quads);
-	auto lines = currentLines();
-	if(lines > 1)
+	// draw runs of glyphs sharing an atlas page with one call
+	auto &r = cmds.renderer();
+	auto &basicEffect = cmds.basicEffect();
+	const Texture *batchPage{};
+	ssize_t batchStart{}, quadIdx{};
+	auto drawBatch = [&]()
 	{
-		auto s = textStr.data();
-		auto spansPtr = &textStr[sizeBeforeLineSpans];
-		int spriteOffset = 0;
-		for(auto i : iotaCount(lines))
+		if(quadIdx == batchStart)
+			return;
+		basicEffect.enableTexture(cmds, *batchPage);
+		cmds.drawQuads<uint16_t>(batchStart, quadIdx - batchStart);
+	};
+	for(auto c : stringView())
+	{
+		if(c == '\n')
+			continue;
+		auto gly = face_->glyphEntry(r, c, false);
+		if(!gly)
 		{
-			auto [xLineSize, charsToDraw] = LineSpan::decode({spansPtr, LineSpan::encodedChar16Size});
-			spansPtr += LineSpan::encodedChar16Size;
-			//log.info("line:{} chars:{}", i, charsToDraw);
-			spriteOffset = drawSpan(cmds, std::u16string_view{s, charsToDraw}, spriteOffset, face_);
-			s += charsToDraw;
+			//log.info("no glyph for {:X}", c);
+			continue;
 		}
+		auto &page = face_->atlasPage(*gly);
+		if(&page != batchPage)
+		{
+			drawBatch();
+			batchPage = &page;
+			batchStart = quadIdx;
+		}
+		quadIdx++;
 	}
-	else
-	{
-		drawSpan(cmds, std::u16string_view{textStr}, 0, face_);
-	}
+	drawBatch();
 }
 
 uint16_t Text::currentLines() const
@@ -16,10 +16,12 @@
 #define LOGTAG "GlyphTexture"
 
 #include <imagine/util/bit.hh>
+#include <imagine/util/math.hh>
 #include <imagine/gfx/Renderer.hh>
 #include <imagine/gfx/GlyphTextureSet.hh>
 #include <imagine/data-type/image/PixmapSource.hh>
 #include <imagine/logger/logger.h>
+#include <algorithm>
 #include <cstdlib>
 
 namespace IG::Gfx
@@ -36,6 +38,10 @@ static constexpr int unicodeBmpUsedChars = unicodeBmpChars - unicodeBmpPrivateCh
 
 static constexpr int glyphTableEntries = unicodeBmpUsedChars;
 
+// empty texels between glyphs so filtering doesn't sample neighbors
+static constexpr int glyphPadding = 1;
+static constexpr int minPageSize = 256, maxPageSize = 1024;
+
 static int mapCharToTable(int c);
 
 static int charIsDrawableUnicode(int c)
@@ -55,37 +61,17 @@ void GlyphTextureSet::resetGlyphTable()
 	logMsg("resetting glyph table");
 	usedGlyphTableBits = 0;
 	glyphTable.resetElements();
+	pages.clear();
+	shelfPos = {};
+	shelfHeight = 0;
+	atlasGeneration_++;
 }
 
 void GlyphTextureSet::freeCaches(uint32_t purgeBits)
 {
-	if(purgeBits == ~0u)
-	{
-		// free the whole table
+	// glyphs share atlas pages, so space can only be reclaimed by freeing the whole table
+	if(usedGlyphTableBits & purgeBits)
 		resetGlyphTable();
-		return;
-	}
-	auto tableBits = usedGlyphTableBits;
-	for(auto i : iotaCount(32))
-	{
-		if((tableBits & 1) && (purgeBits & 1))
-		{
-			logMsg("purging glyphs from table range %d/31", i);
-			int firstChar = i << 11;
-			for(auto c : std::views::iota(firstChar, 2048))
-			{
-				if(mapCharToTable(c) == -1)
-				{
-					//logMsg( "%c not a known drawable character, skipping", c);
-					continue;
-				}
-				glyphTable[i].~GlyphEntry();
-			}
-			usedGlyphTableBits = IG::clearBits(usedGlyphTableBits, IG::bit(i));
-		}
-		tableBits >>= 1;
-		purgeBits >>= 1;
-	}
 }
 
 GlyphTextureSet::GlyphTextureSet(Renderer &r, IG::Font font, IG::FontSettings set):
@@ -134,6 +120,8 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 	resetGlyphTable();
 	settings = set;
 	faceSize = font.makeSize(settings);
+	// size pages to fit roughly 16 rows of glyphs
+	pageSize = std::clamp(int(roundUpPowOf2(unsigned(settings.pixelHeight()) * 16)), minPageSize, maxPageSize);
 	calcMetrics(r);
 	return true;
 }
@@ -141,7 +129,8 @@ bool GlyphTextureSet::setFontSettings(Renderer &r, IG::FontSettings set)
 bool GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 {
 	assert(settings);
-	auto &[glyph, metrics] = glyphTable[tableIdx];
+	auto &entry = glyphTable[tableIdx];
+	auto &metrics = entry.metrics;
 	if(metrics.size.y == -1)
 	{
 		// failed to previously cache char
@@ -156,13 +145,49 @@ bool GlyphTextureSet::cacheChar(Renderer &r, int c, int tableIdx)
 		return false;
 	}
 	//logMsg("setting up table entry %d", tableIdx);
+	auto pix = res.image.pixmap();
+	WPt pos;
+	if(!allocGlyphRect(r, pix.size(), pix.format(), entry.pageIdx, pos))
+	{
+		logErr("glyph:%c (0x%X) size %dx%d doesn't fit in atlas page", c, c, pix.w(), pix.h());
+		metrics.size.y = -1;
+		return false;
+	}
+	pages[entry.pageIdx].write(0, pix, pos);
+	entry.textureBounds = FRect{pos.as<float>(), (pos + pix.size()).as<float>()} / float(pageSize);
+	entry.cached = true;
 	metrics = res.metrics;
-	glyph = r.makeTexture(res.image, glyphSamplerConfig, false);
 	usedGlyphTableBits |= IG::bit((c >> 11) & 0x1F); // use upper 5 BMP plane bits to map in range 0-31
 	//logMsg("used table bits 0x%X", usedGlyphTableBits);
 	return true;
 }
 
+bool GlyphTextureSet::allocGlyphRect(Renderer &r, WSize size, PixelFormat format, uint16_t &pageIdx, WPt &pos)
+{
+	auto paddedSize = size + WSize{glyphPadding, glyphPadding};
+	if(paddedSize.x > pageSize || paddedSize.y > pageSize) [[unlikely]]
+		return false;
+	if(shelfPos.x + paddedSize.x > pageSize)
+	{
+		// start a new shelf
+		shelfPos = {0, shelfPos.y + shelfHeight};
+		shelfHeight = 0;
+	}
+	if(pages.empty() || shelfPos.y + paddedSize.y > pageSize)
+	{
+		logMsg("adding glyph atlas page:%zu size:%d", pages.size(), pageSize);
+		auto &page = pages.emplace_back(r.makeTexture(TextureConfig{{{pageSize, pageSize}, format}, glyphSamplerConfig}));
+		page.clear(0);
+		shelfPos = {};
+		shelfHeight = 0;
+	}
+	pageIdx = pages.size() - 1;
+	pos = shelfPos;
+	shelfPos.x += paddedSize.x;
+	shelfHeight = std::max(shelfHeight, paddedSize.y);
+	return true;
+}
+
 static int mapCharToTable(int c)
 {
 	//logMsg("mapping char 0x%X", c);
@@ -198,7 +223,7 @@ int GlyphTextureSet::precache(Renderer &r, std::string_view string)
 			//logMsg( "%c not a known drawable character, skipping", c);
 			continue;
 		}
-		if(glyphTable[tableIdx].glyph)
+		if(glyphTable[tableIdx].cached)
 		{
 			//logMsg( "%c already cached", c);
 			continue;
@@ -218,7 +243,7 @@ const GlyphEntry *GlyphTextureSet::glyphEntry(Renderer &r, int c, bool allowCach
 		return nullptr;
 	assert(tableIdx < glyphTableEntries);
 	auto &entry = glyphTable[tableIdx];
-	if(!entry.glyph)
+	if(!entry.cached)
 	{
 		if(!allowCache)
 		{
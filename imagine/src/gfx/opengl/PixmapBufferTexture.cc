@@ -15,6 +15,7 @@
 
 #define LOGTAG "GLPixmapBufferTexture"
 #include <imagine/gfx/Renderer.hh>
+#include <imagine/gfx/RendererTask.hh>
 #include <imagine/gfx/PixmapBufferTexture.hh>
 #include <imagine/util/ScopeGuard.hh>
 #include <imagine/util/utility.h>
@@ -71,6 +72,8 @@ PixmapBufferTexture::PixmapBufferTexture(RendererTask &r, TextureConfig config,
 			initWithSystemMemory(r, config, singleBuffer);
 		else if(mode == TextureBufferMode::PBO)
 			initWithPixelBuffer(r, config, singleBuffer);
+		else if(mode == TextureBufferMode::HEADLESS)
+			initHeadless(r, config);
 		else if(Config::envIsAndroid && mode == TextureBufferMode::ANDROID_HARDWARE_BUFFER)
 			initWithHardwareBuffer(r, config, singleBuffer);
 		else if(Config::Gfx::OPENGL_TEXTURE_TARGET_EXTERNAL && mode == TextureBufferMode::ANDROID_SURFACE_TEXTURE)
@@ -105,6 +108,11 @@ void GLPixmapBufferTexture::initWithPixelBuffer(RendererTask &r, TextureConfig c
 	directTex.emplace<GLPixelBufferStorage>(r, config, singleBuffer);
 }
 
+void GLPixmapBufferTexture::initHeadless(RendererTask &r, TextureConfig config)
+{
+	directTex.emplace<HeadlessStorage>(r, config);
+}
+
 #ifdef __ANDROID__
 void GLPixmapBufferTexture::initWithHardwareBuffer(RendererTask &r, TextureConfig config, bool singleBuffer)
 {
@@ -229,6 +237,11 @@ bool PixmapBufferTexture::isExternal() const
 		visit([&](auto &t){ return t.target() == GL_TEXTURE_EXTERNAL_OES; }, directTex);
 }
 
+bool PixmapBufferTexture::isSingleBuffered() const
+{
+	return visit([&](auto &t){ return t.isSingleBuffered(); }, directTex);
+}
+
 template<class Impl, class BufferInfo>
 bool GLTextureStorage<Impl, BufferInfo>::setFormat(PixmapDesc desc, ColorSpace colorSpace, TextureSamplerConfig samplerConf)
 {
@@ -359,6 +372,52 @@ void GLPixelBufferStorage::initBuffer(PixmapDesc desc, bool singleBuffer)
 	}
 }
 
+HeadlessStorage::HeadlessStorage(RendererTask &rTask, TextureConfig config):
+	rTaskPtr{&rTask}
+{
+	initBuffer(config.pixmapDesc);
+}
+
+bool HeadlessStorage::setFormat(PixmapDesc desc, ColorSpace, TextureSamplerConfig)
+{
+	initBuffer(desc);
+	return true;
+}
+
+void HeadlessStorage::initBuffer(PixmapDesc desc)
+{
+	// frames never leave the caller's thread so a single buffer is always enough
+	auto bytes = desc.bytes();
+	storage = std::make_unique<char[]>(bytes);
+	pixDesc = desc;
+	logMsg("allocated headless buffer size:%d data:%p", bytes, storage.get());
+}
+
+LockedTextureBuffer HeadlessStorage::lock(TextureBufferFlags bufferFlags)
+{
+	if(!storage) [[unlikely]]
+	{
+		logErr("called lock when uninitialized");
+		return {};
+	}
+	IG::WindowRect fullRect{{}, pixDesc.size};
+	MutablePixmapView pix{pixDesc, storage.get()};
+	if(bufferFlags.clear)
+		pix.clear();
+	return {storage.get(), pix, fullRect, 0, false};
+}
+
+Renderer &HeadlessStorage::renderer() const
+{
+	return rTaskPtr->renderer();
+}
+
+HeadlessStorage::operator const Texture&() const
+{
+	static const Texture nullTex{};
+	return nullTex;
+}
+
 template class GLTextureStorage<GLSystemMemoryStorage, GLSystemMemoryBufferInfo>;
 template class GLTextureStorage<GLPixelBufferStorage, GLPixelBufferInfo>;
 
@@ -449,6 +508,8 @@ TextureBufferMode Renderer::evalTextureBufferMode(TextureBufferMode mode)
 			return TextureBufferMode::SYSTEM_MEMORY;
 		case TextureBufferMode::PBO:
 			return hasPersistentBufferMapping(*this) ? TextureBufferMode::PBO : evalTextureBufferMode();
+		case TextureBufferMode::HEADLESS:
+			return TextureBufferMode::HEADLESS;
 		#ifdef __ANDROID__
 		case TextureBufferMode::ANDROID_HARDWARE_BUFFER:
 			return hasHardwareBuffer(*this) ? TextureBufferMode::ANDROID_HARDWARE_BUFFER : evalTextureBufferMode();
@@ -460,6 +521,9 @@ TextureBufferMode Renderer::evalTextureBufferMode(TextureBufferMode mode)
 
 TextureBufferMode Renderer::validateTextureBufferMode(TextureBufferMode mode)
 {
+	// headless mode only makes sense when requested directly by a test harness, never from a stored setting
+	if(mode == Gfx::TextureBufferMode::HEADLESS)
+		return Gfx::TextureBufferMode::DEFAULT;
 	if(mode == Gfx::TextureBufferMode::DEFAULT || evalTextureBufferMode(mode) == mode)
 		return mode;
 	return Gfx::TextureBufferMode::DEFAULT;
@@ -25,6 +25,8 @@
 #include <imagine/util/math.hh>
 #include <imagine/util/format.hh>
 #include <imagine/util/string.h>
+#include <algorithm>
+#include <iterator>
 #include <string>
 #include <system_error>
 
@@ -33,6 +35,14 @@ namespace IG
 
 constexpr SystemLogger log{"FSPicker"};
 
+// directories first, then by path
+static bool fileEntryOrder(const FSPicker::FileEntry &e1, const FSPicker::FileEntry &e2)
+{
+	if(e1.isDir != e2.isDir)
+		return e1.isDir;
+	return caselessLexCompare(e1.path, e2.path);
+}
+
 FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::TextureSpan closeRes,
 	FilterFunc filter, Mode mode, Gfx::GlyphTextureSet *face_):
 	View{attach},
@@ -72,15 +82,31 @@ FSPicker::FSPicker(ViewAttachParams attach, Gfx::TextureSpan backRes, Gfx::Textu
 			pushFileLocationsView(e);
 		});
 	controller.setNavView(std::move(nav));
-	controller.push(makeView<TableView>(dir));
+	auto table = makeView<TableView>(
+		[this](TableView::ItemMessage msg) -> TableView::ItemReply
+		{
+			return msg.visit(overloaded
+			{
+				[&](const TableView::ItemsMessage &) -> TableView::ItemReply { return dir.size(); },
+				[&](const TableView::GetItemMessage &m) -> TableView::ItemReply { return &fileItem(m.idx); },
+			});
+		});
+	table->setLazyItems(true);
+	table->setOnSelectElement(
+		[this](const Input::Event &e, int i, MenuItem &)
+		{
+			onSelectEntry(i, e);
+		});
+	controller.push(std::move(table));
 	controller.navView()->showLeftBtn(true);
-	dir.reserve(16); // start with some initial capacity to avoid small reallocations
+	resizeFileItems();
 }
 
 void FSPicker::place()
 {
+	resizeFileItems();
 	controller.place(viewRect(), displayRect());
-	if(dirListThread.isWorking())
+	if(!dirListComplete)
 		return;
 	msgText.compile();
 }
@@ -171,26 +197,24 @@ bool FSPicker::inputEvent(const Input::Event& e, ViewInputEventParams)
 void FSPicker::prepareDraw()
 {
 	controller.navView()->prepareDraw();
+	invalidateFileItems(); // re-create the visible items in case the glyph cache was rebuilt
 	controller.top().prepareDraw();
-	if(dirListThread.isWorking())
+	if(!dirListComplete)
 		return;
 	msgText.makeGlyphs();
 }
 
 void FSPicker::draw(Gfx::RendererCommands &__restrict__ cmds, ViewDrawParams) const
 {
-	if(!dirListThread.isWorking())
+	if(dir.size())
 	{
-		if(dir.size())
-		{
-			controller.top().draw(cmds);
-		}
-		else
-		{
-			using namespace IG::Gfx;
-			cmds.basicEffect().enableAlphaTexture(cmds);
-			msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
-		}
+		controller.top().draw(cmds);
+	}
+	else if(dirListComplete)
+	{
+		using namespace IG::Gfx;
+		cmds.basicEffect().enableAlphaTexture(cmds);
+		msgText.draw(cmds, controller.top().viewRect().pos(C2DO), C2DO, ColorName::WHITE);
 	}
 	controller.navView()->draw(cmds);
 }
@@ -209,6 +233,10 @@ void FSPicker::setEmptyPath(std::string_view message)
 	newFileUIState = {};
 	fileUIStates.clear();
 	dir.clear();
+	invalidateFileItems();
+	pendingDir.clear();
+	pendingDirComplete = false;
+	dirListComplete = true;
 	msgText.resetString(message);
 	if(mode_ == Mode::FILE_IN_DIR)
 	{
@@ -451,6 +479,8 @@ TableView &FSPicker::fileTableView()
 
 void FSPicker::setShowHiddenFiles(bool on)
 {
+	if(showHiddenFiles_ != on)
+		cachedListings.clear();
 	showHiddenFiles_ = on;
 }
 
@@ -467,15 +497,28 @@ void FSPicker::startDirectoryListThread(CStringView path)
 		return;
 	}
 	dir.clear();
-	fileTableView().resetItemSource();
+	invalidateFileItems();
+	pendingDir.clear();
+	pendingDirComplete = false;
+	dirListComplete = false;
 	dirListEvent.setCallback([this]()
 	{
-		fileTableView().resetItemSource(dir);
+		bool firstEntries = dir.empty();
+		if(!mergePendingEntries())
+			return;
 		place();
-		fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
+		if(firstEntries)
+			fileTableView().restoreUIState(std::exchange(newFileUIState, {}));
+		if(dirListComplete)
+			cacheListing();
 		postDraw();
 	});
 	dirListEvent.cancel();
+	if(useCachedListing(path))
+	{
+		dirListEvent.notify();
+		return;
+	}
 	dirListThread.reset([this](WorkThread::Context ctx, const std::string &path)
 	{
 		listDirectory(path, ctx.stop);
@@ -488,10 +531,13 @@ void FSPicker::startDirectoryListThread(CStringView path)
 
 void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 {
+	std::vector<FileEntry> entries;
+	size_t postSize = minCachedListingSize;
+	size_t totalEntries{};
 	try
 	{
 		appContext().forEachInDirectoryUri(path,
-			[this, &stop](auto &entry)
+			[&](auto &entry)
 			{
 				//log.info("entry:{}", entry.path());
 				if(stop) [[unlikely]]
@@ -513,49 +559,21 @@ void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 				{
 					return true;
 				}
-				auto &item = dir.emplace_back(attachParams(), std::string{entry.path()}, entry.name());
-				if(isDir)
-					item.text.flags.user |= FileEntry::isDirFlag;
-				if(mode_ == Mode::DIR && !isDir)
-					item.text.setActive(false);
+				entries.emplace_back(std::string{entry.path()}, std::string{entry.name()}, isDir);
+				totalEntries++;
+				if(entries.size() == postSize)
+				{
+					// post entries in growing batches so the first rows show quickly
+					// without merging into the sorted list too often
+					postPendingEntries(entries, false);
+					postSize = std::min(postSize * 2, maxPostedEntries);
+				}
 				return true;
 			});
-		std::ranges::sort(dir,
-			[](const FileEntry &e1, const FileEntry &e2)
-			{
-				if(e1.isDir() && !e2.isDir())
-					return true;
-				else if(!e1.isDir() && e2.isDir())
-					return false;
-				else
-					return caselessLexCompare(e1.path, e2.path);
-			});
-		if(dir.size())
+		if(stop)
+			return;
+		if(totalEntries)
 		{
-			for(auto &d : dir)
-			{
-				if(!d.text.active())
-					continue;
-				if(d.isDir())
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							assert(!isSingleDirectoryMode());
-							auto path = std::move(dirPath);
-							log.info("entering dir:{}", path);
-							changeDirByInput(path, root.info, e);
-						};
-				}
-				else
-				{
-					d.text.onSelect =
-						[this, &dirPath = d.path](const Input::Event &e)
-						{
-							onSelectPath_.callCopy(*this, dirPath, appContext().fileUriDisplayName(dirPath), e);
-						};
-				}
-			}
 			msgText.resetString();
 		}
 		else // no entries, show a message instead
@@ -571,6 +589,134 @@ void FSPicker::listDirectory(CStringView path, ThreadStop &stop)
 		std::string_view extraMsg = mode_ == Mode::FILE_IN_DIR ? "" : "\nPick a path from the top bar";
 		msgText.resetString(std::format("Can't open directory:\n{}{}", ec.message(), extraMsg));
 		msgText.compile();
+		entries.clear();
+		listingWriteTime = {}; // don't cache a partial listing
+	}
+	postPendingEntries(entries, true);
+}
+
+void FSPicker::postPendingEntries(std::vector<FileEntry> &entries, bool complete)
+{
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		std::ranges::move(entries, std::back_inserter(pendingDir));
+		pendingDirComplete = complete;
+	}
+	entries.clear();
+	if(!complete)
+		dirListEvent.notify();
+}
+
+bool FSPicker::mergePendingEntries()
+{
+	std::vector<FileEntry> entries;
+	bool complete{};
+	{
+		std::scoped_lock lock{pendingDirMutex};
+		entries = std::exchange(pendingDir, {});
+		complete = std::exchange(pendingDirComplete, false);
+	}
+	if(entries.empty() && !complete)
+		return false;
+	if(!std::ranges::is_sorted(entries, fileEntryOrder))
+		std::ranges::sort(entries, fileEntryOrder);
+	if(dir.empty())
+	{
+		dir = std::move(entries);
+	}
+	else if(entries.size())
+	{
+		auto prevSize = dir.size();
+		dir.insert(dir.end(), std::make_move_iterator(entries.begin()), std::make_move_iterator(entries.end()));
+		std::ranges::inplace_merge(dir, dir.begin() + prevSize, fileEntryOrder);
+		invalidateFileItems();
+	}
+	if(complete)
+	{
+		log.info("listed {} entries", dir.size());
+		dirListComplete = true;
+	}
+	return true;
+}
+
+bool FSPicker::useCachedListing(CStringView path)
+{
+	listingPath = path;
+	listingWriteTime = appContext().fileUriLastWriteTime(path);
+	if(listingWriteTime == WallClockTimePoint{})
+		return false;
+	auto it = std::ranges::find(cachedListings, listingPath, &DirListing::path);
+	if(it == cachedListings.end())
+		return false;
+	if(it->lastWriteTime != listingWriteTime)
+	{
+		log.info("directory changed since cached listing:{}", path);
+		cachedListings.erase(it);
+		return false;
+	}
+	log.info("using cached listing:{}", path);
+	pendingDir = it->entries;
+	pendingDirComplete = true;
+	msgText.resetString();
+	return true;
+}
+
+void FSPicker::cacheListing()
+{
+	if(dir.size() < minCachedListingSize || listingWriteTime == WallClockTimePoint{})
+		return;
+	std::erase_if(cachedListings, [&](auto &l){ return l.path == listingPath; });
+	if(cachedListings.size() == maxCachedListings)
+		cachedListings.erase(cachedListings.begin());
+	cachedListings.emplace_back(listingPath, listingWriteTime, dir);
+}
+
+TextMenuItem &FSPicker::fileItem(size_t idx)
+{
+	auto &item = fileItems[idx % fileItems.size()];
+	if(item.entryIdx == idx)
+		return item.text;
+	auto &entry = dir[idx];
+	if(!item.text.text().face())
+		item.text = TextMenuItem{entry.name, attachParams()};
+	else
+		item.text.setName(entry.name);
+	item.text.place();
+	item.text.setActive(mode_ != Mode::DIR || entry.isDir);
+	item.entryIdx = idx;
+	return item.text;
+}
+
+void FSPicker::resizeFileItems()
+{
+	// enough items for every visible row plus the one above it so the table's cells never share an item
+	auto cellYSize = makeEvenRoundedUp(attachParams().viewManager.defaultFace.nominalHeight() * 2);
+	size_t items = cellYSize ? divRoundUp(displayRect().ySize(), cellYSize) + 3 : 0;
+	items = std::max(items, 16uz);
+	if(items == fileItems.size())
+		return;
+	fileItems.resize(items);
+	invalidateFileItems();
+}
+
+void FSPicker::invalidateFileItems()
+{
+	for(auto &item : fileItems) { item.entryIdx = FileItem::noEntry; }
+}
+
+void FSPicker::onSelectEntry(size_t idx, const Input::Event &e)
+{
+	auto &entry = dir[idx];
+	if(entry.isDir)
+	{
+		assert(!isSingleDirectoryMode());
+		auto path = entry.path; // dir is cleared when changing directories
+		log.info("entering dir:{}", path);
+		changeDirByInput(path, root.info, e);
+	}
+	else if(mode_ != Mode::DIR)
+	{
+		onSelectPath_.callCopy(*this, entry.path, appContext().fileUriDisplayName(entry.path), e);
 	}
 }
 
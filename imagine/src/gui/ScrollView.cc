@@ -60,7 +60,7 @@ ScrollView::ScrollView(ViewAttachParams attach):
 				if(scrollVel || isOverScrolled())
 				{
 					if(offset != prevOffset)
-						postDraw();
+						scrolled();
 					return true;
 				}
 			}
@@ -83,12 +83,12 @@ ScrollView::ScrollView(ViewAttachParams attach):
 				else
 				{
 					if(offset != prevOffset)
-						postDraw();
+						scrolled();
 					return true;
 				}
 			}
 			if(offset != prevOffset)
-				postDraw();
+				scrolled();
 			lastFrameTimestamp = {};
 			return false;
 		}
@@ -184,7 +184,7 @@ bool ScrollView::scrollInputEvent(const Input::MotionEvent &e)
 		offset += e.scrolledVertical() < 0 ? -vel : vel;
 		offset = std::clamp(offset, 0, offsetMax);
 		if(offset != prevOffset)
-			postDraw();
+			scrolled();
 		return true;
 	}
 	// click & drag scroll
@@ -228,7 +228,7 @@ bool ScrollView::scrollInputEvent(const Input::MotionEvent &e)
 					}
 				}
 				if(offset != prevOffset)
-					postDraw();
+					scrolled();
 			}
 		},
 		[&](Input::DragTrackerState state, auto)
@@ -261,6 +261,13 @@ void ScrollView::setScrollOffset(int o)
 	dragTracker.reset();
 	stopScrollAnimation();
 	offset = std::clamp(o, 0, offsetMax);
+	onScroll();
+}
+
+void ScrollView::scrolled()
+{
+	onScroll();
+	postDraw();
 }
 
 void ScrollView::stopScrollAnimation()
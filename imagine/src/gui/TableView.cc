@@ -50,6 +50,8 @@ void TableView::highlightCell(int idx)
 		selected = nextSelectableElement(idx, cells_);
 	else
 		selected = -1;
+	if(lazyItems)
+		prepareVisibleCells();
 	postDraw();
 }
 
@@ -60,6 +62,11 @@ void TableView::setAlign(_2DOrigin align)
 
 void TableView::prepareDraw()
 {
+	if(lazyItems)
+	{
+		prepareVisibleCells();
+		return;
+	}
 	auto src = itemSrc;
 	for(auto i : iotaCount(cells()))
 	{
@@ -173,10 +180,13 @@ void TableView::place()
 {
 	auto cells_ = cells();
 	auto src = itemSrc;
-	for(auto i : iotaCount(cells_))
+	if(!lazyItems)
 	{
-		//log.debug("place item:{}", i);
-		item(src, i).place();
+		for(auto i : iotaCount(cells_))
+		{
+			//log.debug("place item:{}", i);
+			item(src, i).place();
+		}
 	}
 	if(cells_)
 	{
@@ -184,6 +194,8 @@ void TableView::place()
 		visibleCells = IG::divRoundUp(displayRect().ySize(), yCellSize) + 1;
 		scrollToFocusRect();
 		selectQuads.write(0, {.bounds = WRect{{}, {viewRect().xSize(), yCellSize-1}}.as<int16_t>()});
+		if(lazyItems)
+			prepareVisibleCells();
 	}
 	else
 		visibleCells = 0;
@@ -262,6 +274,8 @@ bool TableView::inputEvent(const Input::Event& e, ViewInputEventParams)
 		{
 			scrollToFocusRect();
 		}
+		if(lazyItems) // selection changes may have requested cells outside the visible area
+			prepareVisibleCells();
 		return true;
 	}
 	return false;
@@ -493,6 +507,27 @@ bool TableView::handleTableInput(const Input::Event &e, bool &movedSelected)
 	});
 }
 
+void TableView::onScroll()
+{
+	if(lazyItems)
+		prepareVisibleCells();
+}
+
+void TableView::prepareVisibleCells()
+{
+	ssize_t cells_ = cells();
+	if(!cells_ || !yCellSize)
+		return;
+	auto src = itemSrc;
+	// include the cell above the first visible one since draw() checks it when drawing separators
+	ssize_t startYCell = std::clamp(ssize_t(scrollOffset() / yCellSize) - 1, 0z, cells_);
+	ssize_t endYCell = std::clamp(startYCell + visibleCells + 1, 0z, cells_);
+	for(ssize_t i = startYCell; i < endYCell; i++)
+	{
+		item(src, i);
+	}
+}
+
 void TableView::drawElement(Gfx::RendererCommands &__restrict__ cmds, size_t i, MenuItem &item, WRect rect, int xIndent) const
 {
 	static constexpr Gfx::Color highlightColor{0.f, .8f, 1.f};
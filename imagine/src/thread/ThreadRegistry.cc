@@ -0,0 +1,129 @@
+/*  This file is part of Imagine.
+
+	Imagine is free software: you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation, either version 3 of the License, or
+	(at your option) any later version.
+
+	Imagine is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with Imagine.  If not, see <http://www.gnu.org/licenses/> */
+
+#include <imagine/thread/ThreadRegistry.hh>
+#include <imagine/logger/logger.h>
+#ifdef __linux__
+#include <pthread.h>
+#endif
+#include <algorithm>
+
+namespace IG
+{
+
+constexpr SystemLogger log{"ThreadRegistry"};
+
+ThreadRegistry &helperThreads()
+{
+	static ThreadRegistry registry;
+	return registry;
+}
+
+void ThreadRegistry::Registration::reset()
+{
+	if(!registryPtr)
+		return;
+	std::exchange(registryPtr, nullptr)->unregister(id);
+}
+
+ThreadRegistry::Registration ThreadRegistry::registerThisThread(const char *name, ThreadRole role)
+{
+	Entry entry{.id = thisThreadId(), .name = name, .role = role};
+	#ifdef __linux__
+	if(pthread_getcpuclockid(pthread_self(), &entry.cpuClock))
+		entry.cpuClock = {};
+	#endif
+	OnChangeDelegate changeDel;
+	{
+		std::scoped_lock lock{mutex};
+		if(role == ThreadRole::frame)
+		{
+			if(cpuMask)
+				setThreadCPUAffinityMask(std::span{&entry.id, 1}, cpuMask);
+			changeDel = onChange;
+		}
+		if(nice)
+			setThreadPriority(entry.id, *nice);
+		entries.emplace_back(entry);
+	}
+	log.info("registered thread:{} ({})", name, entry.id);
+	changeDel.callSafe();
+	return {*this, entry.id};
+}
+
+void ThreadRegistry::unregister(ThreadId id)
+{
+	OnChangeDelegate changeDel;
+	{
+		std::scoped_lock lock{mutex};
+		auto it = std::ranges::find(entries, id, &Entry::id);
+		if(it == entries.end())
+			return;
+		if(it->role == ThreadRole::frame)
+			changeDel = onChange;
+		entries.erase(it);
+	}
+	changeDel.callSafe();
+}
+
+void ThreadRegistry::addFrameThreadIds(std::vector<ThreadId> &ids) const
+{
+	std::scoped_lock lock{mutex};
+	for(const auto &e : entries)
+	{
+		if(e.role == ThreadRole::frame)
+			ids.emplace_back(e.id);
+	}
+}
+
+void ThreadRegistry::setCPUAffinityMask(CPUMask mask)
+{
+	std::scoped_lock lock{mutex};
+	cpuMask = mask;
+	for(const auto &e : entries)
+	{
+		if(e.role == ThreadRole::frame)
+			setThreadCPUAffinityMask(std::span{&e.id, 1}, mask);
+	}
+}
+
+void ThreadRegistry::setPriority(int nice_)
+{
+	std::scoped_lock lock{mutex};
+	nice = nice_;
+	for(const auto &e : entries)
+	{
+		setThreadPriority(e.id, nice_);
+	}
+}
+
+std::vector<RegisteredThread> ThreadRegistry::threads() const
+{
+	std::scoped_lock lock{mutex};
+	std::vector<RegisteredThread> threads;
+	threads.reserve(entries.size());
+	for(const auto &e : entries)
+	{
+		Nanoseconds cpuTime{};
+		#ifdef __linux__
+		if(timespec t; e.cpuClock && !clock_gettime(e.cpuClock, &t))
+			cpuTime = std::chrono::seconds{t.tv_sec} + Nanoseconds{t.tv_nsec};
+		#endif
+		threads.emplace_back(e.id, e.name, e.role, cpuTime);
+	}
+	return threads;
+}
+
+}
@@ -49,6 +49,20 @@ void setThreadCPUAffinityMask(std::span<const ThreadId> ids, CPUMask mask)
 	#endif
 }
 
+CPUMask threadCPUAffinityMask(ThreadId id)
+{
+	#ifdef __linux__
+	cpu_set_t cpuSet{};
+	if(syscall(__NR_sched_getaffinity, id, sizeof(cpuSet), &cpuSet) < 0)
+		return 0;
+	CPUMask mask;
+	memcpy(&mask, &cpuSet, sizeof(mask));
+	return mask;
+	#else
+	return 0;
+	#endif
+}
+
 void setThreadPriority(ThreadId id, int nice)
 {
 	#ifdef __linux__
@@ -64,6 +78,23 @@ void setThisThreadPriority(int nice)
 	#endif
 }
 
+int threadPriority(ThreadId id)
+{
+	#ifdef __linux__
+	errno = 0;
+	auto nice = getpriority(PRIO_PROCESS, id);
+	if(errno)
+	{
+		if(Config::DEBUG_BUILD)
+			logErr("error:%s getting thread:0x%X nice level", strerror(errno), (unsigned)id);
+		return 0;
+	}
+	return nice;
+	#else
+	return 0;
+	#endif
+}
+
 int thisThreadPriority()
 {
 	#ifdef __linux__